@@ -0,0 +1,551 @@
+//! Primitives 생성 함수 benchmark
+//!
+//! 생성 함수마다 tessellation 크기를 바꿔 가며 실행하고 다음을 측정한다.
+//! - 호출 1회 시간 (최소 / 평균)과 초당 vertex 수
+//! - 호출 1회에 할당한 byte 수와 할당 횟수 (전역 operator new 집계)
+//! - 경우별 최대 RSS (Linux에서는 경우마다 high-water mark를 초기화한다)
+//!
+//! 사용법: toybox_bench [--json <path|->] [--filter <text>]
+//!                      [--min-time <sec>] [--max-vertices <n>]
+//!                      [--threads <n>]
+#include <toybox/async_primitives.hpp>
+#include <toybox/primitives.hpp>
+#include <toybox/simd.hpp>
+#include <toybox/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory_resource>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+using namespace Toybox;
+
+//> 할당량 집계
+//=> 전역 operator new / delete를 모든 형태(배열, nothrow, 정렬 지정)로 바꿔
+//=> operator new를 거치는 할당을 모두 센다. (AlignedAllocator처럼
+//=> aligned_alloc을 직접 부르는 할당은 세지 않는다)
+namespace {
+std::atomic<uint64_t> allocatedBytes(0);
+std::atomic<uint64_t> allocationCount(0);
+
+//! 집계한 뒤 할당한다. 실패하면 nullptr
+void *CountedAllocate(std::size_t size, std::size_t alignment) noexcept {
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (size == 0)
+    size = 1;
+  if (alignment <= alignof(std::max_align_t))
+    return std::malloc(size);
+  //=> 할당 크기는 정렬 단위의 배수여야 한다.
+  size = (size + alignment - 1) / alignment * alignment;
+#if defined(_MSC_VER)
+  return _aligned_malloc(size, alignment);
+#else
+  return std::aligned_alloc(alignment, size);
+#endif
+}
+
+//! inline되면 g++가 operator new의 결과를 free로 해제한다고 잘못 경고하므로
+//! (-Wmismatched-new-delete) 별도 함수로 둔다.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+void CountedFree(void *p, bool aligned) noexcept {
+#if defined(_MSC_VER)
+  if (aligned) {
+    _aligned_free(p);
+    return;
+  }
+#endif
+  (void)aligned;
+  std::free(p);
+}
+
+void *CountedNew(std::size_t size, std::size_t alignment) {
+  if (void *p = CountedAllocate(size, alignment))
+    return p;
+  throw std::bad_alloc();
+}
+
+bool IsExtended(std::align_val_t alignment) {
+  return std::size_t(alignment) > alignof(std::max_align_t);
+}
+} // namespace
+
+void *operator new(std::size_t size) { return CountedNew(size, 0); }
+void *operator new[](std::size_t size) { return CountedNew(size, 0); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAllocate(size, 0);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAllocate(size, 0);
+}
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return CountedNew(size, std::size_t(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return CountedNew(size, std::size_t(alignment));
+}
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+  return CountedAllocate(size, std::size_t(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  return CountedAllocate(size, std::size_t(alignment));
+}
+
+void operator delete(void *p) noexcept { CountedFree(p, false); }
+void operator delete[](void *p) noexcept { CountedFree(p, false); }
+void operator delete(void *p, std::size_t) noexcept { CountedFree(p, false); }
+void operator delete[](void *p, std::size_t) noexcept {
+  CountedFree(p, false);
+}
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+  CountedFree(p, false);
+}
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+  CountedFree(p, false);
+}
+void operator delete(void *p, std::align_val_t alignment) noexcept {
+  CountedFree(p, IsExtended(alignment));
+}
+void operator delete[](void *p, std::align_val_t alignment) noexcept {
+  CountedFree(p, IsExtended(alignment));
+}
+void operator delete(void *p, std::size_t,
+                     std::align_val_t alignment) noexcept {
+  CountedFree(p, IsExtended(alignment));
+}
+void operator delete[](void *p, std::size_t,
+                       std::align_val_t alignment) noexcept {
+  CountedFree(p, IsExtended(alignment));
+}
+void operator delete(void *p, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+  CountedFree(p, IsExtended(alignment));
+}
+void operator delete[](void *p, std::align_val_t alignment,
+                       const std::nothrow_t &) noexcept {
+  CountedFree(p, IsExtended(alignment));
+}
+
+namespace {
+//> 최대 RSS
+//! 경우별 최대 RSS를 재기 위해 high-water mark를 초기화한다.
+//! 초기화할 수 없으면 false이며, 이때 값은 process 전체의 최대값이다.
+bool ResetPeakRss() {
+#if defined(__linux__)
+  std::ofstream file("/proc/self/clear_refs");
+  file << "5";
+  file.flush();
+  return bool(file);
+#else
+  return false;
+#endif
+}
+
+uint64_t PeakRssBytes() {
+#if defined(__linux__)
+  std::ifstream file("/proc/self/status");
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0)
+      return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return uint64_t(usage.ru_maxrss) * 1024;
+#else
+  return 0;
+#endif
+}
+
+//> benchmark 경우
+struct BenchCase {
+  std::string generator;
+  size_t size; // tessellation 크기 (생성 함수별 의미가 다르다)
+  size_t vertexCount;
+  size_t indexCount;
+  std::function<size_t()> run; // 생성한 vertex 수를 반환한다.
+
+  std::string Name() const { return generator + "/" + std::to_string(size); }
+};
+
+struct BenchResult {
+  const BenchCase *bench;
+  size_t iterations;
+  double bestSeconds;
+  double meanSeconds;
+  uint64_t bytesPerCall;
+  uint64_t allocationsPerCall;
+  uint64_t peakRssBytes;
+};
+
+struct Options {
+  std::string jsonPath;
+  std::string filter;
+  double minTime = 0.2;
+  size_t maxVertices = 0; // 0이면 제한 없음
+  size_t threads = 0;     // 0이면 병렬 생성 함수를 측정하지 않음
+};
+
+template <typename MeshType> size_t VertexCountOf(const MeshType &mesh) {
+  return mesh.vertexes.size();
+}
+
+template <typename Params, typename Make>
+BenchCase MakeCase(const std::string &generator, size_t size,
+                   const Params &params, Make make) {
+  BenchCase bench;
+  bench.generator = generator;
+  bench.size = size;
+  bench.vertexCount = Primitives::VertexCount(params);
+  bench.indexCount = Primitives::IndexCount(params);
+  bench.run = [params, make]() { return VertexCountOf(make(params)); };
+  return bench;
+}
+
+//! scene 경우: 작은 객체를 여러 개 만든다. (cube, sphere, cylinder 반복)
+constexpr size_t kSceneObjectCount = 1024;
+const CubeParams kSceneCube{LIGHTHAND, 1.0f};
+const SphereParams kSceneSphere{1.0f, 16, 8};
+const CylinderParams kSceneCylinder{LIGHTHAND, 1.0f, 2.0f, 360.0f / 16};
+
+//! resource가 있으면 PmrMesh를, 없으면 Mesh를 만든다.
+template <typename Meshes, typename... Resource>
+size_t BuildScene(Meshes &meshes, Resource... resource) {
+  meshes.reserve(kSceneObjectCount);
+  size_t vertexCount = 0;
+  for (size_t i = 0; i < kSceneObjectCount; ++i) {
+    if (i % 3 == 0)
+      meshes.push_back(Primitives::MakeCube(kSceneCube, resource...));
+    else if (i % 3 == 1)
+      meshes.push_back(Primitives::MakeSphere(kSceneSphere, resource...));
+    else
+      meshes.push_back(Primitives::MakeCylinder(kSceneCylinder, resource...));
+    vertexCount += meshes.back().vertexes.size();
+  }
+  return vertexCount;
+}
+
+void AddSceneCases(std::vector<BenchCase> &cases, ThreadPool *pool) {
+  BenchCase scene;
+  scene.generator = "scene";
+  scene.size = kSceneObjectCount;
+  scene.vertexCount = scene.indexCount = 0;
+  for (size_t i = 0; i < kSceneObjectCount; ++i) {
+    scene.vertexCount += i % 3 == 0   ? Primitives::VertexCount(kSceneCube)
+                         : i % 3 == 1 ? Primitives::VertexCount(kSceneSphere)
+                                      : Primitives::VertexCount(kSceneCylinder);
+    scene.indexCount += i % 3 == 0   ? Primitives::IndexCount(kSceneCube)
+                        : i % 3 == 1 ? Primitives::IndexCount(kSceneSphere)
+                                     : Primitives::IndexCount(kSceneCylinder);
+  }
+  scene.run = []() {
+    std::vector<Mesh> meshes;
+    return BuildScene(meshes);
+  };
+  cases.push_back(scene);
+
+  //=> arena는 한 번 잡은 buffer를 호출마다 다시 쓰므로 malloc/free가 없다.
+  //=> 정렬 여유를 두고 예상 크기의 2배를 잡는다.
+  size_t arenaBytes = 2 * (scene.vertexCount * sizeof(Vertex) +
+                           scene.indexCount * sizeof(uint32_t) +
+                           kSceneObjectCount * (sizeof(PmrMesh) + 64));
+  auto buffer = std::make_shared<std::vector<unsigned char>>(arenaBytes);
+  BenchCase arena = scene;
+  arena.generator = "scene_arena";
+  arena.run = [buffer]() {
+    std::pmr::monotonic_buffer_resource resource(buffer->data(),
+                                                 buffer->size());
+    std::pmr::vector<PmrMesh> meshes(&resource);
+    return BuildScene(meshes, &resource);
+  };
+  cases.push_back(arena);
+
+  //=> 같은 scene을 한 batch로 pool에 넘기고 모든 future를 기다린다.
+  if (pool != nullptr) {
+    std::vector<PrimitiveRequest> requests;
+    for (size_t i = 0; i < kSceneObjectCount; ++i) {
+      if (i % 3 == 0)
+        requests.push_back(kSceneCube);
+      else if (i % 3 == 1)
+        requests.push_back(kSceneSphere);
+      else
+        requests.push_back(kSceneCylinder);
+    }
+    BenchCase async = scene;
+    async.generator = "scene_async";
+    async.run = [pool, requests]() {
+      auto futures = AsyncPrimitives::GenerateBatch(*pool, requests);
+      size_t vertexCount = 0;
+      for (auto &future : futures)
+        vertexCount += future.get().vertexes.size();
+      return vertexCount;
+    };
+    cases.push_back(async);
+  }
+}
+
+std::vector<BenchCase> BuildCases(ThreadPool *pool) {
+  std::vector<BenchCase> cases;
+
+  cases.push_back(MakeCase("cube", 1, CubeParams{LIGHTHAND, 1.0f},
+                           [](const CubeParams &p) {
+                             return Primitives::MakeCube(p);
+                           }));
+  cases.push_back(MakeCase("sandclock", 1, SandClockParams{LIGHTHAND},
+                           [](const SandClockParams &p) {
+                             return Primitives::MakeSandClock(p);
+                           }));
+  cases.push_back(
+      MakeCase("frustum", 1, FrustumParams{{0, 0, 0}, 60.0f, 90.0f, 100.0f},
+               [](const FrustumParams &p) {
+                 return Primitives::MakeFrustum(p);
+               }));
+
+  //=> grid: 16^2 ~ 4096^2
+  for (int n = 16; n <= 4096; n *= 2) {
+    GridParams params{LIGHTHAND, n, n, 1.0f};
+    cases.push_back(MakeCase("grid", n, params, [](const GridParams &p) {
+      return Primitives::MakeGrid(p);
+    }));
+    if (pool != nullptr)
+      cases.push_back(
+          MakeCase("grid_parallel", n, params, [pool](const GridParams &p) {
+            return Primitives::MakeGrid(p, *pool);
+          }));
+  }
+
+  //=> sphere: slice 8 ~ 2048, stack은 slice의 절반
+  for (int n = 8; n <= 2048; n *= 2) {
+    SphereParams params{1.0f, n, n / 2};
+    cases.push_back(MakeCase("sphere", n, params, [](const SphereParams &p) {
+      return Primitives::MakeSphere(p);
+    }));
+    if (pool != nullptr)
+      cases.push_back(MakeCase("sphere_parallel", n, params,
+                               [pool](const SphereParams &p) {
+                                 return Primitives::MakeSphere(p, *pool);
+                               }));
+  }
+
+  //=> cylinder: 둘레 분할 16 ~ 65536
+  for (int n = 16; n <= 65536; n *= 4) {
+    CylinderParams params{LIGHTHAND, 1.0f, 2.0f, 360.0f / n};
+    cases.push_back(MakeCase("cylinder", n, params,
+                             [](const CylinderParams &p) {
+                               return Primitives::MakeCylinder(p);
+                             }));
+  }
+
+  //=> icosphere: level 0 ~ 8. cache를 쓰면 크기만 바꾼다.
+  for (int level = 0; level <= 8; ++level) {
+    IcosphereParams params{1.0f, level};
+    params.useUnitCache = true;
+    cases.push_back(MakeCase("icosphere", level, params,
+                             [](const IcosphereParams &p) {
+                               return Primitives::MakeIcosphere(p);
+                             }));
+    params.useUnitCache = false;
+    //=> 앞의 case가 채운 cache를 읽지 않도록 매번 비운다.
+    cases.push_back(MakeCase("icosphere_nocache", level, params,
+                             [](const IcosphereParams &p) {
+                               Primitives::ReleaseIcospheres();
+                               return Primitives::MakeIcosphere(p);
+                             }));
+  }
+
+  AddSceneCases(cases, pool);
+  return cases;
+}
+
+//> 실행
+BenchResult RunCase(const BenchCase &bench, double minTime) {
+  using Clock = std::chrono::steady_clock;
+  BenchResult result = {};
+  result.bench = &bench;
+  ResetPeakRss();
+
+  //=> 첫 호출은 준비 단계이다. (vertex 개수 확인, cache 준비 등)
+  if (bench.run() != bench.vertexCount)
+    throw std::runtime_error(bench.Name() + ": vertex 개수가 VertexCount와 "
+                                            "다릅니다.");
+
+  //=> 최소 3회, 총 minTime 이상 실행한다. 할당량은 첫 측정 호출에서 잰다.
+  double total = 0.0;
+  result.bestSeconds = std::numeric_limits<double>::max();
+  while (result.iterations < 3 || total < minTime) {
+    uint64_t bytesBefore = allocatedBytes.load();
+    uint64_t countBefore = allocationCount.load();
+    Clock::time_point start = Clock::now();
+    bench.run();
+    double seconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    if (result.iterations == 0) {
+      result.bytesPerCall = allocatedBytes.load() - bytesBefore;
+      result.allocationsPerCall = allocationCount.load() - countBefore;
+    }
+    result.bestSeconds = std::min(result.bestSeconds, seconds);
+    total += seconds;
+    ++result.iterations;
+  }
+  result.meanSeconds = total / result.iterations;
+  result.peakRssBytes = PeakRssBytes();
+  return result;
+}
+
+double VertexesPerSecond(const BenchResult &result) {
+  return result.bestSeconds > 0.0
+             ? double(result.bench->vertexCount) / result.bestSeconds
+             : 0.0;
+}
+
+//> 출력
+const char *SimdName(SimdLevelEnum level) {
+  switch (level) {
+  case SIMD_AVX2:
+    return "avx2";
+  case SIMD_SSE:
+    return "sse";
+  default:
+    return "scalar";
+  }
+}
+
+void PrintHeader(std::FILE *out) {
+  std::fprintf(out, "%-24s %10s %10s %12s %12s %12s %10s %10s\n", "case",
+               "vertices", "iters", "best(us)", "mean(us)", "Mvert/s",
+               "alloc(KB)", "rss(MB)");
+}
+
+void PrintRow(std::FILE *out, const BenchResult &r) {
+  std::fprintf(out, "%-24s %10zu %10zu %12.2f %12.2f %12.2f %10.1f %10.1f\n",
+               r.bench->Name().c_str(), r.bench->vertexCount, r.iterations,
+               r.bestSeconds * 1e6, r.meanSeconds * 1e6,
+               VertexesPerSecond(r) / 1e6, r.bytesPerCall / 1024.0,
+               r.peakRssBytes / (1024.0 * 1024.0));
+  std::fflush(out);
+}
+
+std::string ToJson(const std::vector<BenchResult> &results,
+                   const Options &options, bool perCaseRss) {
+  char date[32] = {};
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+  std::ostringstream json;
+  json.precision(6);
+  json << "{\n  \"context\": {\n"
+       << "    \"date\": \"" << date << "\",\n"
+       << "    \"simd\": \"" << SimdName(DetectSimdLevel()) << "\",\n"
+       << "    \"threads\": " << options.threads << ",\n"
+       << "    \"min_time_seconds\": " << options.minTime << ",\n"
+       << "    \"per_case_peak_rss\": " << (perCaseRss ? "true" : "false")
+       << "\n  },\n  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchResult &r = results[i];
+    json << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << r.bench->Name()
+         << "\", \"generator\": \"" << r.bench->generator
+         << "\", \"size\": " << r.bench->size
+         << ", \"vertices\": " << r.bench->vertexCount
+         << ", \"indices\": " << r.bench->indexCount
+         << ", \"iterations\": " << r.iterations
+         << ", \"best_ns\": " << std::fixed << r.bestSeconds * 1e9
+         << ", \"mean_ns\": " << r.meanSeconds * 1e9
+         << ", \"vertices_per_second\": " << VertexesPerSecond(r)
+         << std::defaultfloat << ", \"bytes_allocated\": " << r.bytesPerCall
+         << ", \"allocations\": " << r.allocationsPerCall
+         << ", \"peak_rss_bytes\": " << r.peakRssBytes << "}";
+  }
+  json << "\n  ]\n}\n";
+  return json.str();
+}
+
+Options ParseOptions(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto value = [&]() -> std::string {
+      if (i + 1 >= argc)
+        throw std::runtime_error(arg + " 뒤에 값이 필요합니다.");
+      return argv[++i];
+    };
+    if (arg == "--json")
+      options.jsonPath = value();
+    else if (arg == "--filter")
+      options.filter = value();
+    else if (arg == "--min-time")
+      options.minTime = std::stod(value());
+    else if (arg == "--max-vertices")
+      options.maxVertices = std::stoull(value());
+    else if (arg == "--threads")
+      options.threads = std::stoull(value());
+    else
+      throw std::runtime_error("알 수 없는 옵션: " + arg);
+  }
+  return options;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    Options options = ParseOptions(argc, argv);
+    std::unique_ptr<ThreadPool> pool;
+    if (options.threads > 0)
+      pool.reset(new ThreadPool(options.threads));
+
+    const std::vector<BenchCase> cases = BuildCases(pool.get());
+    const bool perCaseRss = ResetPeakRss();
+    const bool jsonToStdout = options.jsonPath == "-";
+    std::vector<BenchResult> results;
+    if (!jsonToStdout)
+      PrintHeader(stdout);
+    for (const BenchCase &bench : cases) {
+      if (bench.Name().find(options.filter) == std::string::npos)
+        continue;
+      if (options.maxVertices != 0 && bench.vertexCount > options.maxVertices)
+        continue;
+      results.push_back(RunCase(bench, options.minTime));
+      if (!jsonToStdout)
+        PrintRow(stdout, results.back());
+    }
+
+    if (!options.jsonPath.empty()) {
+      std::string json = ToJson(results, options, perCaseRss);
+      if (jsonToStdout) {
+        std::fputs(json.c_str(), stdout);
+      } else {
+        std::ofstream file(options.jsonPath);
+        file << json;
+        if (!file)
+          throw std::runtime_error("JSON 파일을 쓸 수 없습니다: " +
+                                   options.jsonPath);
+      }
+    }
+    return 0;
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "toybox_bench: %s\n", e.what());
+    return 1;
+  }
+}
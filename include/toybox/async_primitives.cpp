@@ -0,0 +1,211 @@
+#include "toybox/async_primitives.hpp"
+#include "toybox/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+using namespace Toybox;
+
+namespace {
+//! 생성 결과 또는 예외를 받는 함수. 요청마다 정확히 한 번 호출된다.
+using Completion = std::function<void(Mesh &&, std::exception_ptr)>;
+
+//> 입력값 종류별 생성 함수
+Mesh Make(const CubeParams &params) { return Primitives::MakeCube(params); }
+Mesh Make(const CylinderParams &params) {
+  return Primitives::MakeCylinder(params);
+}
+Mesh Make(const GridParams &params) { return Primitives::MakeGrid(params); }
+Mesh Make(const SandClockParams &params) {
+  return Primitives::MakeSandClock(params);
+}
+Mesh Make(const SphereParams &params) { return Primitives::MakeSphere(params); }
+Mesh Make(const IcosphereParams &params) {
+  return Primitives::MakeIcosphere(params);
+}
+Mesh Make(const SquareParams &params) { return Primitives::MakeSquare(params); }
+Mesh Make(const AxisParams &params) { return Primitives::MakeAxis(params); }
+Mesh Make(const FrustumParams &params) {
+  return Primitives::MakeFrustum(params);
+}
+
+//> 행 단위로 나누어 생성할 수 있는 입력값
+template <typename Params>
+constexpr bool kRowSplittable = std::is_same<Params, GridParams>::value ||
+                                std::is_same<Params, SandClockParams>::value ||
+                                std::is_same<Params, SphereParams>::value;
+
+void MakeRows(const GridParams &params, Mesh &mesh, int rowBegin, int rowEnd) {
+  Primitives::MakeGridRows(params, Span<Vertex>(mesh.vertexes),
+                           Span<uint32_t>(mesh.indexes), rowBegin, rowEnd);
+}
+void MakeRows(const SandClockParams &params, Mesh &mesh, int rowBegin,
+              int rowEnd) {
+  Primitives::MakeSandClockRows(params, Span<Vertex>(mesh.vertexes),
+                                Span<uint32_t>(mesh.indexes), rowBegin,
+                                rowEnd);
+}
+void MakeRows(const SphereParams &params, Mesh &mesh, int rowBegin,
+              int rowEnd) {
+  Primitives::MakeSphereRows(params, Span<Vertex>(mesh.vertexes),
+                             Span<uint32_t>(mesh.indexes), rowBegin, rowEnd);
+}
+
+//! 한 요청을 행 단위 하위 작업으로 나누어 pool에 추가한다.
+//! 마지막으로 끝난 하위 작업이 done을 호출하므로 기다리는 thread가 없다.
+template <typename Params>
+void GenerateRows(ThreadPool &pool, const Params &request,
+                  const AsyncGenerateParams &params, Completion done) {
+  struct SplitState {
+    Params request;
+    Mesh mesh;
+    std::atomic<int> remaining{0};
+    std::mutex mutex;
+    std::exception_ptr error;
+    Completion done;
+  };
+  auto state = std::make_shared<SplitState>();
+  state->request = request;
+  state->done = std::move(done);
+  state->mesh.vertexes.resize(Primitives::VertexCount(request));
+  state->mesh.indexes.resize(Primitives::IndexCount(request));
+
+  //=> 하위 작업 하나가 subJobVertexCount개 정도의 vertex를 맡도록 행을 묶는다.
+  const int rowCount = Primitives::RowCount(request);
+  size_t rowVertexCount =
+      std::max<size_t>(1, state->mesh.vertexes.size() / size_t(rowCount));
+  int grain = int(std::min<size_t>(
+      rowCount, std::max<size_t>(1, params.subJobVertexCount / rowVertexCount)));
+  state->remaining = (rowCount + grain - 1) / grain;
+
+  for (int row = 0; row < rowCount; row += grain) {
+    int rowEnd = std::min(rowCount, row + grain);
+    pool.Submit([state, row, rowEnd]() {
+      try {
+        MakeRows(state->request, state->mesh, row, rowEnd);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->error)
+          state->error = std::current_exception();
+      }
+      if (--state->remaining > 0)
+        return;
+
+      //=> 모든 행이 기록되었다.
+      if (state->error)
+        state->done(Mesh(), state->error);
+      else
+        state->done(std::move(state->mesh), nullptr);
+    });
+  }
+}
+
+//! worker에서 요청 하나를 처리한다.
+void GenerateOne(ThreadPool &pool, const PrimitiveRequest &request,
+                 const AsyncGenerateParams &params, const Completion &done) {
+  std::visit(
+      [&](const auto &generatorParams) {
+        using Params = std::decay_t<decltype(generatorParams)>;
+        Mesh mesh;
+        try {
+          if constexpr (kRowSplittable<Params>) {
+            if (Primitives::RowCount(generatorParams) > 1 &&
+                Primitives::VertexCount(generatorParams) >
+                    params.splitVertexCount) {
+              GenerateRows(pool, generatorParams, params, done);
+              return;
+            }
+          }
+          mesh = Make(generatorParams);
+        } catch (...) {
+          done(Mesh(), std::current_exception());
+          return;
+        }
+        done(std::move(mesh), nullptr);
+      },
+      request);
+}
+
+void Submit(ThreadPool &pool, const PrimitiveRequest &request,
+            const AsyncGenerateParams &params, Completion done) {
+  pool.Submit([&pool, request, params, done = std::move(done)]() {
+    GenerateOne(pool, request, params, done);
+  });
+}
+
+//! future로 결과를 전달하는 Completion
+Completion MakePromiseCompletion(std::future<Mesh> &future) {
+  auto promise = std::make_shared<std::promise<Mesh>>();
+  future = promise->get_future();
+  return [promise](Mesh &&mesh, std::exception_ptr error) {
+    if (error)
+      promise->set_exception(error);
+    else
+      promise->set_value(std::move(mesh));
+  };
+}
+} // namespace
+
+std::future<Mesh> AsyncPrimitives::Generate(ThreadPool &pool,
+                                            const PrimitiveRequest &request,
+                                            const AsyncGenerateParams &params) {
+  std::future<Mesh> future;
+  Submit(pool, request, params, MakePromiseCompletion(future));
+  return future;
+}
+
+std::vector<std::future<Mesh>>
+AsyncPrimitives::GenerateBatch(ThreadPool &pool,
+                               const std::vector<PrimitiveRequest> &requests,
+                               const AsyncGenerateParams &params) {
+  std::vector<std::future<Mesh>> futures(requests.size());
+  for (size_t i = 0; i < requests.size(); ++i)
+    Submit(pool, requests[i], params, MakePromiseCompletion(futures[i]));
+  return futures;
+}
+
+std::future<void>
+AsyncPrimitives::GenerateBatch(ThreadPool &pool,
+                               const std::vector<PrimitiveRequest> &requests,
+                               PrimitiveCallback onComplete,
+                               const AsyncGenerateParams &params) {
+  //> 모든 callback이 끝나면 batch future를 준비 상태로 만든다.
+  struct BatchState {
+    std::atomic<size_t> remaining{0};
+    std::mutex mutex;
+    std::exception_ptr error;
+    std::promise<void> finished;
+    PrimitiveCallback onComplete;
+  };
+  auto batch = std::make_shared<BatchState>();
+  batch->remaining = requests.size();
+  batch->onComplete = std::move(onComplete);
+  std::future<void> future = batch->finished.get_future();
+  if (requests.empty()) {
+    batch->finished.set_value();
+    return future;
+  }
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    Submit(pool, requests[i], params,
+           [batch, i](Mesh &&mesh, std::exception_ptr error) {
+             try {
+               batch->onComplete(i, std::move(mesh), error);
+             } catch (...) {
+               std::lock_guard<std::mutex> lock(batch->mutex);
+               if (!batch->error)
+                 batch->error = std::current_exception();
+             }
+             if (--batch->remaining > 0)
+               return;
+
+             if (batch->error)
+               batch->finished.set_exception(batch->error);
+             else
+               batch->finished.set_value();
+           });
+  }
+  return future;
+}
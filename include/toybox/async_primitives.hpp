@@ -0,0 +1,66 @@
+#ifndef TOYBOX_ASYNC_PRIMITIVES_H
+#define TOYBOX_ASYNC_PRIMITIVES_H
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <toybox/primitives.hpp>
+#include <toybox/vertex.hpp>
+#include <variant>
+#include <vector>
+
+namespace Toybox {
+
+class ThreadPool;
+
+//! 비동기 생성 요청 하나. 생성 함수의 입력값 중 하나를 담는다.
+using PrimitiveRequest =
+    std::variant<CubeParams, CylinderParams, GridParams, SandClockParams,
+                 SphereParams, IcosphereParams, SquareParams, AxisParams,
+                 FrustumParams>;
+
+//! 요청 하나가 끝나면 worker thread에서 호출된다.
+//! 생성에 실패하면 mesh는 비어 있고 error에 예외가 들어 있다.
+using PrimitiveCallback = std::function<void(
+    size_t requestIndex, Mesh &&mesh, std::exception_ptr error)>;
+
+//! 큰 요청을 나누는 기준
+struct AsyncGenerateParams {
+  //! vertex 개수가 이보다 많은 Grid / SandClock / Sphere는 행 단위 하위
+  //! 작업으로 나누어 여러 worker가 함께 생성한다.
+  size_t splitVertexCount = 64 * 1024;
+  //! 하위 작업 하나가 맡는 vertex 개수 (행 단위로 맞춘다)
+  size_t subJobVertexCount = 16 * 1024;
+};
+
+//! 생성 요청을 ThreadPool에 넘기고 바로 반환한다.
+//! loader thread는 기다리지 않고 파일 I/O나 GPU upload를 계속할 수 있다.
+//! - 요청마다 작업 하나를 만들고, 큰 요청은 그 작업이 행 단위 하위 작업으로
+//!   나눈다. 하위 작업은 그 worker의 queue에 들어가므로 일이 없는 worker가
+//!   가져가 함께 생성한다.
+//! - 결과는 같은 요청을 Primitives::Make*로 생성한 것과 byte 단위로 동일하다.
+//! - 모든 작업이 끝나기 전에 pool을 소멸시키면 안 된다.
+class AsyncPrimitives {
+public:
+  //! 생성 중 발생한 예외는 future.get()에서 다시 던진다.
+  static std::future<Mesh>
+  Generate(ThreadPool &pool, const PrimitiveRequest &request,
+           const AsyncGenerateParams &params = AsyncGenerateParams());
+
+  //! requests와 같은 순서의 future 목록
+  static std::vector<std::future<Mesh>>
+  GenerateBatch(ThreadPool &pool, const std::vector<PrimitiveRequest> &requests,
+                const AsyncGenerateParams &params = AsyncGenerateParams());
+
+  //! 요청이 끝나는 순서대로 onComplete를 호출한다.
+  //! 반환된 future는 모든 onComplete가 끝나면 준비되며, onComplete가 던진
+  //! 첫 번째 예외를 get()에서 다시 던진다.
+  static std::future<void>
+  GenerateBatch(ThreadPool &pool, const std::vector<PrimitiveRequest> &requests,
+                PrimitiveCallback onComplete,
+                const AsyncGenerateParams &params = AsyncGenerateParams());
+};
+} // namespace Toybox
+
+#endif
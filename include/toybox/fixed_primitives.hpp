@@ -0,0 +1,251 @@
+#ifndef TOYBOX_FIXED_PRIMITIVES_H
+#define TOYBOX_FIXED_PRIMITIVES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <toybox/primitives.hpp>
+#include <toybox/span.hpp>
+#include <toybox/vertex.hpp>
+
+namespace Toybox {
+
+//! 컴파일 시간에 만든 vertex / index 배열. 읽기 전용 data에 놓이며 실행 시
+//! 초기화나 할당이 없다.
+template <size_t VertexCount, size_t IndexCount> struct FixedMesh {
+  std::array<Vertex, VertexCount> vertexes;
+  std::array<uint32_t, IndexCount> indexes;
+
+  Span<const Vertex> Vertexes() const {
+    return Span<const Vertex>(vertexes.data(), vertexes.size());
+  }
+  Span<const uint32_t> Indexes() const {
+    return Span<const uint32_t>(indexes.data(), indexes.size());
+  }
+
+  //! 배열을 그대로 복사한 Mesh
+  Mesh ToMesh() const {
+    Mesh mesh;
+    mesh.vertexes.assign(vertexes.begin(), vertexes.end());
+    mesh.indexes.assign(indexes.begin(), indexes.end());
+    return mesh;
+  }
+};
+
+namespace detail {
+//! 생성 함수들과 같은 원주율 근사값 (결과를 맞추기 위해 그대로 쓴다)
+constexpr double kPrimitivePi = 3.141592;
+constexpr double kExactPi = 3.14159265358979323846;
+
+//! constexpr sin / cos / sqrt. [-pi, pi]로 옮긴 뒤 Taylor 급수로 계산하며
+//! float로 쓰기에 충분한 정밀도를 가진다.
+constexpr double ConstSin(double x) {
+  double turns = x / (2.0 * kExactPi);
+  long long whole = static_cast<long long>(turns < 0.0 ? turns - 0.5
+                                                       : turns + 0.5);
+  x -= double(whole) * 2.0 * kExactPi;
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 14; ++n) {
+    term *= -x * x / double((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr double ConstCos(double x) { return ConstSin(x + kExactPi / 2.0); }
+
+constexpr double ConstSqrt(double x) {
+  if (!(x > 0.0))
+    return 0.0;
+  double guess = x < 1.0 ? 1.0 : x;
+  for (int i = 0; i < 64; ++i)
+    guess = 0.5 * (guess + x / guess);
+  return guess;
+}
+
+//! 사각형 face마다 두 삼각형 (0, 1, 2), (0, 2, 3)
+template <size_t VertexCount, size_t IndexCount>
+constexpr void WriteQuadIndexes(FixedMesh<VertexCount, IndexCount> &mesh) {
+  for (uint32_t face = 0; face < IndexCount / 6; ++face) {
+    uint32_t base = face * 4;
+    uint32_t quad[] = {base, base + 1, base + 2, base, base + 2, base + 3};
+    for (size_t k = 0; k < 6; ++k)
+      mesh.indexes[face * 6 + k] = quad[k];
+  }
+}
+
+//! Primitives::MakeCube(system, 2.0f)의 위치, normal, texcoord (color는 0)
+constexpr FixedMesh<24, 36> MakeFixedCube(CoordSystemEnum system) {
+  FixedMesh<24, 36> mesh{};
+  const float xList[] = {-1, -1, 1, 1};
+  const float yList[] = {-1, 1, 1, -1};
+  const float txList[] = {0, 0, 1, 1};
+  const float tyList[] = {1, 0, 0, 1};
+  const float reversePlane[] = {-1, 1};
+  size_t i = 0;
+  for (int axis = 0; axis < 3; ++axis) {
+    for (float rev : reversePlane) {
+      for (int k = 0; k < 4; ++k, ++i) {
+        float x = system == LEFTHAND ? -rev * xList[k] : yList[k];
+        float y = system == LEFTHAND ? yList[k] : -rev * xList[k];
+        Vertex &v = mesh.vertexes[i];
+        //=> 면의 축에 rev, 나머지 두 축에 x, y를 차례로 넣는다.
+        float *position[] = {&v.x, &v.y, &v.z};
+        *position[axis] = rev;
+        *position[(axis + 1) % 3] = x;
+        *position[(axis + 2) % 3] = y;
+        v.nx = v.x;
+        v.ny = v.y;
+        v.nz = v.z;
+        v.tx = txList[k];
+        v.ty = tyList[k];
+      }
+    }
+  }
+  WriteQuadIndexes(mesh);
+  return mesh;
+}
+
+//! Primitives::MakeSquare()와 같은 값
+constexpr FixedMesh<4, 6> MakeFixedSquare() {
+  FixedMesh<4, 6> mesh{};
+  const float xList[] = {-1.0f, 1.0f, 1.0f, -1.0f};
+  const float yList[] = {1.0f, 1.0f, -1.0f, -1.0f};
+  const float txList[] = {0.0f, 1.0f, 1.0f, 0.0f};
+  const float tyList[] = {0.0f, 0.0f, 1.0f, 1.0f};
+  for (size_t i = 0; i < 4; ++i)
+    mesh.vertexes[i] = Vertex{xList[i], yList[i], 0.0f,     0.0f,
+                              0.0f,     1.0f,     0.0f,     0.0f,
+                              -1.0f,    txList[i], tyList[i]};
+  WriteQuadIndexes(mesh);
+  return mesh;
+}
+
+//! Primitives::MakeAxis()와 같은 값. 원점에서 x, y, z축으로 향하는 선분 3개
+constexpr FixedMesh<6, 6> MakeFixedAxis() {
+  FixedMesh<6, 6> mesh{};
+  for (size_t axis = 0; axis < 3; ++axis) {
+    Vertex &origin = mesh.vertexes[axis * 2];
+    Vertex &tip = mesh.vertexes[axis * 2 + 1];
+    float *tipPosition[] = {&tip.x, &tip.y, &tip.z};
+    float *originColor[] = {&origin.r, &origin.g, &origin.b};
+    float *tipColor[] = {&tip.r, &tip.g, &tip.b};
+    *tipPosition[axis] = 1.0f;
+    *originColor[axis] = 1.0f;
+    *tipColor[axis] = 1.0f;
+  }
+  for (uint32_t i = 0; i < 6; ++i)
+    mesh.indexes[i] = i;
+  return mesh;
+}
+
+//! Primitives::MakeSphere(1.0f, Slices, Stacks)와 같은 배치의 단위 구.
+//! 값은 같은 식을 double로 계산하므로 실행 시 생성 결과와 마지막 bit가
+//! 다를 수 있다.
+template <int Slices, int Stacks>
+constexpr FixedMesh<size_t(Slices + 1) * (Stacks + 1),
+                    size_t(Slices) * Stacks * 6>
+MakeFixedSphere() {
+  FixedMesh<size_t(Slices + 1) * (Stacks + 1), size_t(Slices) * Stacks * 6>
+      mesh{};
+  const float dTheta = float(-(kPrimitivePi * 2) / Slices);
+  const float dPhi = float(-kPrimitivePi / Stacks);
+  size_t v = 0;
+  for (int i = 0; i <= Stacks; ++i) {
+    float ringRadius = float(ConstSin(double(dPhi * i)));
+    float y = float(-ConstCos(double(dPhi * i)));
+    float length = float(ConstSqrt(double(ringRadius) * ringRadius +
+                                   double(y) * y));
+    float normalScale = ringRadius / length;
+    float ny = y / length;
+    for (int j = 0; j <= Slices; ++j, ++v) {
+      float c = float(ConstCos(double(dTheta * j)));
+      float s = float(ConstSin(double(dTheta * j)));
+      Vertex &vertex = mesh.vertexes[v];
+      vertex.x = ringRadius * c;
+      vertex.y = y;
+      vertex.z = -ringRadius * s;
+      vertex.nx = normalScale * c;
+      vertex.ny = ny;
+      vertex.nz = -normalScale * s;
+      vertex.tx = float(j) / Slices;
+      vertex.ty = 1.0f - float(i) / Stacks;
+    }
+  }
+
+  size_t index = 0;
+  for (int j = 0; j < Stacks; ++j) {
+    uint32_t offset = uint32_t((Slices + 1) * j);
+    for (uint32_t i = 0; i < uint32_t(Slices); ++i) {
+      uint32_t next = offset + i + Slices + 1;
+      uint32_t quad[] = {offset + i, next, next + 1,
+                         offset + i, next + 1, offset + i + 1};
+      for (uint32_t k : quad)
+        mesh.indexes[index++] = k;
+    }
+  }
+  return mesh;
+}
+
+//! Primitives::MakeCylinder(system, r, 1.0f, 360.0f / Segments)와 같은 배치의
+//! 높이 1인 원기둥. (MakeCylinder는 system과 반지름을 사용하지 않는다)
+template <int Segments>
+constexpr FixedMesh<size_t(Segments) * 2, size_t(Segments) * 6>
+MakeFixedCylinder() {
+  FixedMesh<size_t(Segments) * 2, size_t(Segments) * 6> mesh{};
+  const float unitAngle = 360.0f / Segments;
+  const float unitRadian = float(unitAngle / 180.0f * kPrimitivePi);
+  size_t v = 0;
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < Segments; ++x, ++v) {
+      Vertex &vertex = mesh.vertexes[v];
+      vertex.x = float(ConstSin(double(unitRadian * x)));
+      vertex.y = float(y);
+      vertex.z = float(ConstCos(double(unitRadian * x)));
+      vertex.nx = vertex.x;
+      vertex.ny = vertex.y;
+      vertex.nz = vertex.z;
+      vertex.tx = float(x) / float(Segments - 1);
+      vertex.ty = float(1 - y);
+    }
+  }
+  for (uint32_t x = 0; x < uint32_t(Segments); ++x) {
+    uint32_t nextX = x + 1 == uint32_t(Segments) ? 0 : x + 1;
+    uint32_t quad[] = {x,         Segments + x, Segments + nextX,
+                       x,         Segments + nextX, nextX};
+    for (size_t k = 0; k < 6; ++k)
+      mesh.indexes[size_t(x) * 6 + k] = quad[k];
+  }
+  return mesh;
+}
+} // namespace detail
+
+//> 컴파일 시간 table
+//! 한 변이 2인 cube. MakeCube는 이 table에 크기만 곱한다.
+template <CoordSystemEnum System>
+inline constexpr FixedMesh<24, 36> kFixedCube = detail::MakeFixedCube(System);
+
+inline constexpr FixedMesh<4, 6> kFixedSquare = detail::MakeFixedSquare();
+
+inline constexpr FixedMesh<6, 6> kFixedAxis = detail::MakeFixedAxis();
+
+//! 반지름 1인 UV 구. 컴파일 시간이 늘어나지 않도록 작은 크기만 허용한다.
+template <int Slices, int Stacks>
+inline constexpr auto kFixedSphere = [] {
+  static_assert(Slices >= 3 && Stacks >= 2 && Slices * Stacks <= 4096,
+                "kFixedSphere는 3 <= Slices, 2 <= Stacks, "
+                "Slices * Stacks <= 4096 이어야 합니다.");
+  return detail::MakeFixedSphere<Slices, Stacks>();
+}();
+
+//! 높이 1인 원기둥. 둘레를 Segments개로 나눈다.
+template <int Segments>
+inline constexpr auto kFixedCylinder = [] {
+  static_assert(Segments >= 3 && Segments <= 4096,
+                "kFixedCylinder는 3 <= Segments <= 4096 이어야 합니다.");
+  return detail::MakeFixedCylinder<Segments>();
+}();
+} // namespace Toybox
+
+#endif
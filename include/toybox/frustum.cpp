@@ -0,0 +1,333 @@
+#include "toybox/frustum.hpp"
+#include "toybox/utils.hpp"
+#include <cmath>
+#include <stdexcept>
+
+#if defined(TOYBOX_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+using namespace Toybox;
+
+namespace {
+Plane MakePlane(float nx, float ny, float nz, float d) {
+  float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+  return Plane{nx / length, ny / length, nz / length, d / length};
+}
+
+//! 평면별로 normal 방향에서 가장 먼 box 꼭짓점(positive vertex)의 배열을
+//! 고른다. box마다 비교하지 않고 평면마다 한 번만 고르면 된다.
+struct AabbPlane {
+  Plane plane;
+  const float *x;
+  const float *y;
+  const float *z;
+};
+
+void SelectPositiveVertex(const Plane (&planes)[6], const AabbArrays &boxes,
+                          AabbPlane (&out)[6]) {
+  for (int k = 0; k < 6; ++k) {
+    const Plane &p = planes[k];
+    out[k].plane = p;
+    out[k].x = p.nx >= 0.0f ? boxes.maxX : boxes.minX;
+    out[k].y = p.ny >= 0.0f ? boxes.maxY : boxes.minY;
+    out[k].z = p.nz >= 0.0f ? boxes.maxZ : boxes.minZ;
+  }
+}
+
+size_t CullAabbsScalar(const AabbPlane (&planes)[6], size_t begin, size_t end,
+                       uint32_t *visible) {
+  size_t visibleCount = 0;
+  for (size_t i = begin; i < end; ++i) {
+    bool inside = true;
+    for (int k = 0; k < 6; ++k) {
+      const AabbPlane &p = planes[k];
+      inside &= p.plane.Distance(p.x[i], p.y[i], p.z[i]) >= 0.0f;
+    }
+    //=> 분기 없이 기록하고, 보일 때만 개수를 늘린다.
+    visible[visibleCount] = uint32_t(i);
+    visibleCount += inside;
+  }
+  return visibleCount;
+}
+
+size_t CullSpheresScalar(const Plane (&planes)[6],
+                         const SphereArrays &spheres, size_t begin, size_t end,
+                         uint32_t *visible) {
+  size_t visibleCount = 0;
+  for (size_t i = begin; i < end; ++i) {
+    bool inside = true;
+    for (int k = 0; k < 6; ++k)
+      inside &= planes[k].Distance(spheres.centerX[i], spheres.centerY[i],
+                                   spheres.centerZ[i]) >= -spheres.radius[i];
+    visible[visibleCount] = uint32_t(i);
+    visibleCount += inside;
+  }
+  return visibleCount;
+}
+
+//! 판정 결과 bit mask에서 보이는 번호만 이어서 기록한다.
+inline size_t WriteVisible(int mask, int laneCount, size_t first,
+                           uint32_t *visible) {
+  //=> 대부분의 물체는 보이지 않으므로 모두 제외된 묶음은 바로 넘어간다.
+  if (mask == 0)
+    return 0;
+  size_t visibleCount = 0;
+  for (int lane = 0; lane < laneCount; ++lane) {
+    visible[visibleCount] = uint32_t(first + lane);
+    visibleCount += (mask >> lane) & 1;
+  }
+  return visibleCount;
+}
+
+#if defined(TOYBOX_SIMD_X86)
+TOYBOX_TARGET_SSE size_t CullAabbsSSE(const AabbPlane (&planes)[6],
+                                      size_t count, uint32_t *visible) {
+  size_t visibleCount = 0;
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int k = 0; k < 6; ++k) {
+      const AabbPlane &p = planes[k];
+      __m128 distance = _mm_add_ps(
+          _mm_add_ps(
+              _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.plane.nx),
+                                    _mm_loadu_ps(p.x + i)),
+                         _mm_mul_ps(_mm_set1_ps(p.plane.ny),
+                                    _mm_loadu_ps(p.y + i))),
+              _mm_mul_ps(_mm_set1_ps(p.plane.nz), _mm_loadu_ps(p.z + i))),
+          _mm_set1_ps(p.plane.d));
+      inside =
+          _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+    }
+    visibleCount += WriteVisible(_mm_movemask_ps(inside), 4, i,
+                                 visible + visibleCount);
+  }
+  return visibleCount +
+         CullAabbsScalar(planes, i, count, visible + visibleCount);
+}
+
+TOYBOX_TARGET_AVX2 size_t CullAabbsAVX2(const AabbPlane (&planes)[6],
+                                        size_t count, uint32_t *visible) {
+  size_t visibleCount = 0;
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (int k = 0; k < 6; ++k) {
+      const AabbPlane &p = planes[k];
+      __m256 distance = _mm256_add_ps(
+          _mm256_add_ps(
+              _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.plane.nx),
+                                          _mm256_loadu_ps(p.x + i)),
+                            _mm256_mul_ps(_mm256_set1_ps(p.plane.ny),
+                                          _mm256_loadu_ps(p.y + i))),
+              _mm256_mul_ps(_mm256_set1_ps(p.plane.nz),
+                            _mm256_loadu_ps(p.z + i))),
+          _mm256_set1_ps(p.plane.d));
+      inside = _mm256_and_ps(
+          inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+    }
+    visibleCount += WriteVisible(_mm256_movemask_ps(inside), 8, i,
+                                 visible + visibleCount);
+  }
+  return visibleCount +
+         CullAabbsScalar(planes, i, count, visible + visibleCount);
+}
+
+TOYBOX_TARGET_SSE size_t CullSpheresSSE(const Plane (&planes)[6],
+                                        const SphereArrays &spheres,
+                                        uint32_t *visible) {
+  size_t visibleCount = 0;
+  size_t i = 0;
+  for (; i + 4 <= spheres.count; i += 4) {
+    __m128 x = _mm_loadu_ps(spheres.centerX + i);
+    __m128 y = _mm_loadu_ps(spheres.centerY + i);
+    __m128 z = _mm_loadu_ps(spheres.centerZ + i);
+    __m128 negRadius =
+        _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radius + i));
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int k = 0; k < 6; ++k) {
+      const Plane &p = planes[k];
+      __m128 distance = _mm_add_ps(
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.nx), x),
+                                _mm_mul_ps(_mm_set1_ps(p.ny), y)),
+                     _mm_mul_ps(_mm_set1_ps(p.nz), z)),
+          _mm_set1_ps(p.d));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+    }
+    visibleCount += WriteVisible(_mm_movemask_ps(inside), 4, i,
+                                 visible + visibleCount);
+  }
+  return visibleCount + CullSpheresScalar(planes, spheres, i, spheres.count,
+                                          visible + visibleCount);
+}
+
+TOYBOX_TARGET_AVX2 size_t CullSpheresAVX2(const Plane (&planes)[6],
+                                          const SphereArrays &spheres,
+                                          uint32_t *visible) {
+  size_t visibleCount = 0;
+  size_t i = 0;
+  for (; i + 8 <= spheres.count; i += 8) {
+    __m256 x = _mm256_loadu_ps(spheres.centerX + i);
+    __m256 y = _mm256_loadu_ps(spheres.centerY + i);
+    __m256 z = _mm256_loadu_ps(spheres.centerZ + i);
+    __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(),
+                                     _mm256_loadu_ps(spheres.radius + i));
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (int k = 0; k < 6; ++k) {
+      const Plane &p = planes[k];
+      __m256 distance = _mm256_add_ps(
+          _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.nx), x),
+                                      _mm256_mul_ps(_mm256_set1_ps(p.ny), y)),
+                        _mm256_mul_ps(_mm256_set1_ps(p.nz), z)),
+          _mm256_set1_ps(p.d));
+      inside = _mm256_and_ps(inside,
+                             _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+    }
+    visibleCount += WriteVisible(_mm256_movemask_ps(inside), 8, i,
+                                 visible + visibleCount);
+  }
+  return visibleCount + CullSpheresScalar(planes, spheres, i, spheres.count,
+                                          visible + visibleCount);
+}
+#endif
+} // namespace
+
+//> 생성
+Frustum::Frustum(const FrustumParams &params, float nearPlaneDistance) {
+  //=> far plane 크기는 Primitives::MakeFrustum과 같은 식으로 계산한다.
+  float far = params.farPlaneDistance;
+  float halfHeight =
+      Utils::instance().CalcLengthBasedOnFoV(params.fovDegHeight, far) / 2.f;
+  float halfWidth =
+      Utils::instance().CalcLengthBasedOnFoV(params.fovDegWidth, far) / 2.f;
+  const float *o = params.origin;
+
+  //=> MakeFrustum처럼 far plane의 모서리는 origin과 무관하게
+  //=> (+-halfWidth, +-halfHeight, far)에 있다. 옆면 4개는 origin(꼭짓점)과
+  //=> far plane의 한 변을 지난다.
+  auto throughOrigin = [o](float nx, float ny, float nz) {
+    return MakePlane(nx, ny, nz, -(nx * o[0] + ny * o[1] + nz * o[2]));
+  };
+  const float depth = far - o[2];
+  planes[FRUSTUM_LEFT] = throughOrigin(depth, 0.0f, halfWidth + o[0]);
+  planes[FRUSTUM_RIGHT] = throughOrigin(-depth, 0.0f, halfWidth - o[0]);
+  planes[FRUSTUM_BOTTOM] = throughOrigin(0.0f, depth, halfHeight + o[1]);
+  planes[FRUSTUM_TOP] = throughOrigin(0.0f, -depth, halfHeight - o[1]);
+  planes[FRUSTUM_NEAR] = Plane{0.0f, 0.0f, 1.0f, -(o[2] + nearPlaneDistance)};
+  planes[FRUSTUM_FAR] = Plane{0.0f, 0.0f, -1.0f, far};
+}
+
+Frustum::Frustum(const FrustumParams &params, const Transform &cameraToWorld,
+                 float nearPlaneDistance)
+    : Frustum(params, nearPlaneDistance) {
+  //=> 평면 normal은 역전치 행렬로 변환한다. p_w = M p_c + t 이면
+  //=> n_w = M^-T n_c, d_w = d_c - n_w . t
+  const float *m = cameraToWorld.m;
+  float cof[9] = {m[5] * m[10] - m[6] * m[9], m[6] * m[8] - m[4] * m[10],
+                  m[4] * m[9] - m[5] * m[8],  m[2] * m[9] - m[1] * m[10],
+                  m[0] * m[10] - m[2] * m[8], m[1] * m[8] - m[0] * m[9],
+                  m[1] * m[6] - m[2] * m[5],  m[2] * m[4] - m[0] * m[6],
+                  m[0] * m[5] - m[1] * m[4]};
+  float det = m[0] * cof[0] + m[1] * cof[1] + m[2] * cof[2];
+  if (det == 0.0f)
+    throw std::runtime_error("역행렬이 없는 변환은 사용할 수 없습니다.");
+
+  for (auto &plane : planes) {
+    const float n[3] = {plane.nx / det, plane.ny / det, plane.nz / det};
+    float nx = cof[0] * n[0] + cof[1] * n[1] + cof[2] * n[2];
+    float ny = cof[3] * n[0] + cof[4] * n[1] + cof[5] * n[2];
+    float nz = cof[6] * n[0] + cof[7] * n[1] + cof[8] * n[2];
+    float d = plane.d - (nx * m[3] + ny * m[7] + nz * m[11]);
+    plane = MakePlane(nx, ny, nz, d);
+  }
+}
+
+Frustum Frustum::FromPlanes(const Plane (&planes)[6]) {
+  Frustum frustum;
+  for (int k = 0; k < 6; ++k)
+    frustum.planes[k] = planes[k];
+  return frustum;
+}
+
+//> 단일 판정
+bool Frustum::ContainsPoint(float x, float y, float z) const {
+  for (const auto &plane : planes)
+    if (plane.Distance(x, y, z) < 0.0f)
+      return false;
+  return true;
+}
+
+bool Frustum::IntersectsAabb(const float (&boxMin)[3],
+                             const float (&boxMax)[3]) const {
+  for (const auto &plane : planes) {
+    float x = plane.nx >= 0.0f ? boxMax[0] : boxMin[0];
+    float y = plane.ny >= 0.0f ? boxMax[1] : boxMin[1];
+    float z = plane.nz >= 0.0f ? boxMax[2] : boxMin[2];
+    if (plane.Distance(x, y, z) < 0.0f)
+      return false;
+  }
+  return true;
+}
+
+bool Frustum::IntersectsSphere(float x, float y, float z,
+                               float radius) const {
+  for (const auto &plane : planes)
+    if (plane.Distance(x, y, z) < -radius)
+      return false;
+  return true;
+}
+
+//> 일괄 판정
+size_t Frustum::CullAabbs(const AabbArrays &boxes, uint32_t *visible) const {
+  return CullAabbs(DetectSimdLevel(), boxes, visible);
+}
+
+size_t Frustum::CullSpheres(const SphereArrays &spheres,
+                            uint32_t *visible) const {
+  return CullSpheres(DetectSimdLevel(), spheres, visible);
+}
+
+size_t Frustum::CullAabbs(const AabbArrays &boxes,
+                          std::vector<uint32_t> &visible) const {
+  visible.resize(boxes.count);
+  visible.resize(CullAabbs(boxes, visible.data()));
+  return visible.size();
+}
+
+size_t Frustum::CullSpheres(const SphereArrays &spheres,
+                            std::vector<uint32_t> &visible) const {
+  visible.resize(spheres.count);
+  visible.resize(CullSpheres(spheres, visible.data()));
+  return visible.size();
+}
+
+size_t Frustum::CullAabbs(SimdLevelEnum level, const AabbArrays &boxes,
+                          uint32_t *visible) const {
+  AabbPlane aabbPlanes[6];
+  SelectPositiveVertex(planes, boxes, aabbPlanes);
+  switch (level) {
+#if defined(TOYBOX_SIMD_X86)
+  case SIMD_AVX2:
+    return CullAabbsAVX2(aabbPlanes, boxes.count, visible);
+  case SIMD_SSE:
+    return CullAabbsSSE(aabbPlanes, boxes.count, visible);
+#endif
+  default:
+    return CullAabbsScalar(aabbPlanes, 0, boxes.count, visible);
+  }
+}
+
+size_t Frustum::CullSpheres(SimdLevelEnum level, const SphereArrays &spheres,
+                            uint32_t *visible) const {
+  switch (level) {
+#if defined(TOYBOX_SIMD_X86)
+  case SIMD_AVX2:
+    return CullSpheresAVX2(planes, spheres, visible);
+  case SIMD_SSE:
+    return CullSpheresSSE(planes, spheres, visible);
+#endif
+  default:
+    return CullSpheresScalar(planes, spheres, 0, spheres.count, visible);
+  }
+}
@@ -0,0 +1,103 @@
+#ifndef TOYBOX_FRUSTUM_H
+#define TOYBOX_FRUSTUM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <toybox/mesh_batch.hpp>
+#include <toybox/primitives.hpp>
+#include <toybox/simd.hpp>
+#include <vector>
+
+namespace Toybox {
+
+//! nx * x + ny * y + nz * z + d >= 0 인 쪽이 안쪽인 평면. normal은 단위 벡터다.
+struct Plane {
+  float nx;
+  float ny;
+  float nz;
+  float d;
+
+  float Distance(float x, float y, float z) const {
+    return nx * x + ny * y + nz * z + d;
+  }
+};
+
+//! 축 정렬 bounding box 배열 (SoA). 각 포인터는 count개의 값을 가리킨다.
+struct AabbArrays {
+  const float *minX;
+  const float *minY;
+  const float *minZ;
+  const float *maxX;
+  const float *maxY;
+  const float *maxZ;
+  size_t count;
+};
+
+//! bounding sphere 배열 (SoA)
+struct SphereArrays {
+  const float *centerX;
+  const float *centerY;
+  const float *centerZ;
+  const float *radius;
+  size_t count;
+};
+
+enum FrustumPlaneEnum {
+  FRUSTUM_LEFT,
+  FRUSTUM_RIGHT,
+  FRUSTUM_BOTTOM,
+  FRUSTUM_TOP,
+  FRUSTUM_NEAR,
+  FRUSTUM_FAR
+};
+
+//! 6개 평면으로 이루어진 시야 절두체
+//! FrustumParams로 만들면 Primitives::MakeFrustum이 그리는 선과 같은
+//! 모양이다. 꼭짓점은 origin이고, far plane은 origin과 무관하게 z = far에
+//! 있으며 크기는 FoV에서 정해진다. (origin.z < far이어야 한다)
+//!
+//! 판정은 보수적이다. 보이는 물체는 항상 통과하며, 절두체 모서리 근처의
+//! 보이지 않는 box가 일부 통과할 수 있다.
+class Frustum {
+public:
+  //! nearPlaneDistance는 origin에서 near plane까지의 거리이다.
+  explicit Frustum(const FrustumParams &params, float nearPlaneDistance = 0.0f);
+  //! cameraToWorld로 변환한 절두체 (카메라 좌표계 -> 월드 좌표계)
+  Frustum(const FrustumParams &params, const Transform &cameraToWorld,
+          float nearPlaneDistance = 0.0f);
+
+  //! 평면을 직접 지정한다. 순서는 FrustumPlaneEnum을 따른다.
+  static Frustum FromPlanes(const Plane (&planes)[6]);
+
+  const Plane &GetPlane(FrustumPlaneEnum plane) const { return planes[plane]; }
+
+  bool ContainsPoint(float x, float y, float z) const;
+  bool IntersectsAabb(const float (&boxMin)[3], const float (&boxMax)[3]) const;
+  bool IntersectsSphere(float x, float y, float z, float radius) const;
+
+  //! 보이는 물체의 번호를 오름차순으로 visible에 기록하고 그 개수를 반환한다.
+  //! visible은 count개 이상의 공간이 있어야 한다.
+  //! CPU가 지원하면 AVX2 / SSE로 여러 개를 한 번에 판정한다.
+  size_t CullAabbs(const AabbArrays &boxes, uint32_t *visible) const;
+  size_t CullSpheres(const SphereArrays &spheres, uint32_t *visible) const;
+
+  //! visible의 크기를 보이는 물체 수로 맞춘다.
+  size_t CullAabbs(const AabbArrays &boxes,
+                   std::vector<uint32_t> &visible) const;
+  size_t CullSpheres(const SphereArrays &spheres,
+                     std::vector<uint32_t> &visible) const;
+
+  //! SIMD 수준을 직접 지정한다. (결과 비교 및 성능 측정용)
+  size_t CullAabbs(SimdLevelEnum level, const AabbArrays &boxes,
+                   uint32_t *visible) const;
+  size_t CullSpheres(SimdLevelEnum level, const SphereArrays &spheres,
+                     uint32_t *visible) const;
+
+private:
+  Frustum() = default;
+
+  Plane planes[6];
+};
+} // namespace Toybox
+
+#endif
@@ -0,0 +1,257 @@
+#include "toybox/icosphere.hpp"
+#include "toybox/primitives.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+using namespace Toybox;
+
+namespace {
+//! edge (a, b) -> 중점 vertex 번호의 open addressing hash table
+class MidpointTable {
+public:
+  explicit MidpointTable(size_t edgeCount) {
+    size_t capacity = 16;
+    while (capacity < edgeCount * 2)
+      capacity *= 2;
+    mask = capacity - 1;
+    keys.assign(capacity, UINT64_MAX);
+    values.resize(capacity);
+  }
+
+  //! edge의 중점 번호를 찾는다. 없으면 nextIndex를 등록하고 inserted를
+  //! true로 둔다.
+  uint32_t Find(uint32_t a, uint32_t b, uint32_t nextIndex, bool &inserted) {
+    uint64_t key = a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+    uint64_t h = key * 0x9E3779B97F4A7C15ull;
+    size_t index = size_t(h ^ (h >> 32)) & mask;
+    while (keys[index] != UINT64_MAX) {
+      if (keys[index] == key) {
+        inserted = false;
+        return values[index];
+      }
+      index = (index + 1) & mask;
+    }
+    keys[index] = key;
+    values[index] = nextIndex;
+    inserted = true;
+    return nextIndex;
+  }
+
+private:
+  size_t mask;
+  std::vector<uint64_t> keys;
+  std::vector<uint32_t> values;
+};
+
+void CheckLevel(int level) {
+  if (level < 0 || level > kMaxIcosphereLevel)
+    throw std::runtime_error("icosphere level이 지원 범위를 벗어났습니다.");
+}
+
+std::shared_ptr<UnitIcosphere> MakeIcosahedron() {
+  const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+  const float corners[12][3] = {{-1, t, 0}, {1, t, 0},   {-1, -t, 0},
+                                {1, -t, 0}, {0, -1, t},  {0, 1, t},
+                                {0, -1, -t}, {0, 1, -t}, {t, 0, -1},
+                                {t, 0, 1},  {-t, 0, -1}, {-t, 0, 1}};
+  const uint32_t faces[60] = {0, 11, 5,  0, 5,  1,  0, 1,  7,  0, 7,  10,
+                              0, 10, 11, 1, 5,  9,  5, 11, 4,  11, 10, 2,
+                              10, 7, 6,  7, 1,  8,  3, 9,  4,  3, 4,  2,
+                              3, 2,  6,  3, 6,  8,  3, 8,  9,  4, 9,  5,
+                              2, 4,  11, 6, 2,  10, 8, 6,  7,  9, 8,  1};
+  const float length = std::sqrt(1.0f + t * t);
+
+  auto sphere = std::make_shared<UnitIcosphere>();
+  for (const auto &corner : corners)
+    for (float value : corner)
+      sphere->positions.push_back(value / length);
+  sphere->indexes.assign(faces, faces + 60);
+  sphere->sharedCount = 12;
+  return sphere;
+}
+
+//! 삼각형 하나를 4개로 나누고 edge 중점을 구 위로 옮긴다.
+//! seam에서 나눈 복사본은 원본 vertex로 되돌려 나누므로 중점을 공유한다.
+std::shared_ptr<UnitIcosphere> Subdivide(const UnitIcosphere &in, int level) {
+  const size_t triangleCount = in.indexes.size() / 3;
+  auto sharedIndex = [&in](uint32_t index) {
+    return index < in.sharedCount ? index
+                                  : in.splitSources[index - in.sharedCount];
+  };
+  auto out = std::make_shared<UnitIcosphere>();
+  out->positions.reserve(IcosphereVertexCount(level) * 3);
+  out->positions.assign(in.positions.begin(),
+                        in.positions.begin() + in.sharedCount * 3);
+  out->indexes.resize(triangleCount * 12);
+
+  //=> 닫힌 삼각형 mesh이므로 edge 수는 삼각형 수의 1.5배이다.
+  MidpointTable midpoints(triangleCount * 3 / 2);
+  for (size_t t = 0; t < triangleCount; ++t) {
+    const uint32_t tri[3] = {sharedIndex(in.indexes[t * 3]),
+                             sharedIndex(in.indexes[t * 3 + 1]),
+                             sharedIndex(in.indexes[t * 3 + 2])};
+    uint32_t mid[3];
+    for (int k = 0; k < 3; ++k) {
+      uint32_t a = tri[k], b = tri[(k + 1) % 3];
+      bool inserted;
+      mid[k] = midpoints.Find(a, b, uint32_t(out->positions.size() / 3),
+                              inserted);
+      if (!inserted)
+        continue;
+      float p[3];
+      for (int c = 0; c < 3; ++c)
+        p[c] = in.positions[a * 3 + c] + in.positions[b * 3 + c];
+      float length = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+      for (int c = 0; c < 3; ++c)
+        out->positions.push_back(p[c] / length);
+    }
+    const uint32_t result[12] = {tri[0], mid[0], mid[2], mid[0],
+                                 tri[1], mid[1], mid[2], mid[1],
+                                 tri[2], mid[0], mid[1], mid[2]};
+    std::copy(result, result + 12, &out->indexes[t * 12]);
+  }
+  out->sharedCount = out->positions.size() / 3;
+  return out;
+}
+
+//! 경도/위도 texture 좌표를 쓰고 seam과 극점의 vertex를 나눈다.
+//! - 경도 0(u = 0 / 1)을 가로지르는 삼각형은 u < 0.5인 vertex 대신 u + 1인
+//!   복사본을 사용한다. 따라서 u는 1을 조금 넘을 수 있다. (repeat 주소 모드)
+//! - 극점은 경도가 정해지지 않으므로 삼각형마다 복사본을 두고, u는 나머지
+//!   두 vertex의 평균으로 둔다.
+//! 복사본은 sharedCount 뒤에 삼각형 순서대로 붙는다.
+void WriteTexcoords(UnitIcosphere &sphere) {
+  const float kPi = 3.14159265f;
+  const size_t sharedCount = sphere.sharedCount;
+  sphere.texcoords.resize(sharedCount * 2);
+  for (size_t i = 0; i < sharedCount; ++i) {
+    const float *p = &sphere.positions[i * 3];
+    float u = 0.5f + std::atan2(p[2], p[0]) / (2.0f * kPi);
+    float v = std::acos(std::max(-1.0f, std::min(1.0f, p[1]))) / kPi;
+    sphere.texcoords[i * 2] = u;
+    sphere.texcoords[i * 2 + 1] = v;
+  }
+
+  auto isPole = [&sphere](uint32_t i) {
+    const float *p = &sphere.positions[size_t(i) * 3];
+    return p[0] == 0.0f && p[2] == 0.0f;
+  };
+  auto addCopy = [&sphere](uint32_t source, float u) {
+    for (int c = 0; c < 3; ++c)
+      sphere.positions.push_back(sphere.positions[source * 3 + c]);
+    sphere.texcoords.push_back(u);
+    sphere.texcoords.push_back(sphere.texcoords[source * 2 + 1]);
+    sphere.splitSources.push_back(source);
+    return uint32_t(sphere.positions.size() / 3 - 1);
+  };
+
+  std::vector<uint32_t> seamCopies(sharedCount, UINT32_MAX);
+  std::vector<char> poleUsed(sharedCount, 0);
+  for (size_t t = 0; t < sphere.indexes.size() / 3; ++t) {
+    uint32_t *tri = &sphere.indexes[t * 3];
+    float u[3];
+    float minU = 1.0f, maxU = 0.0f;
+    for (int k = 0; k < 3; ++k) {
+      u[k] = sphere.texcoords[tri[k] * 2];
+      if (!isPole(tri[k])) {
+        minU = std::min(minU, u[k]);
+        maxU = std::max(maxU, u[k]);
+      }
+    }
+
+    if (maxU - minU > 0.5f) {
+      for (int k = 0; k < 3; ++k) {
+        if (isPole(tri[k]) || u[k] >= 0.5f)
+          continue;
+        uint32_t &copy = seamCopies[tri[k]];
+        if (copy == UINT32_MAX)
+          copy = addCopy(tri[k], u[k] + 1.0f);
+        tri[k] = copy;
+        u[k] += 1.0f;
+      }
+    }
+
+    for (int k = 0; k < 3; ++k) {
+      if (!isPole(tri[k]))
+        continue;
+      float poleU = 0.5f * (u[(k + 1) % 3] + u[(k + 2) % 3]);
+      //=> 처음 만난 삼각형은 원본을 쓰고, 나머지는 복사본을 만든다.
+      if (!poleUsed[tri[k]]) {
+        poleUsed[tri[k]] = 1;
+        sphere.texcoords[tri[k] * 2] = poleU;
+      } else {
+        tri[k] = addCopy(tri[k], poleU);
+      }
+    }
+  }
+}
+
+//! base(level baseLevel)에서 level까지 나눈다.
+std::shared_ptr<UnitIcosphere> SubdivideFrom(const UnitIcosphere &base,
+                                             int baseLevel, int level) {
+  std::shared_ptr<UnitIcosphere> sphere;
+  const UnitIcosphere *current = &base;
+  for (int i = baseLevel + 1; i <= level; ++i) {
+    sphere = Subdivide(*current, i);
+    current = sphere.get();
+  }
+  if (!sphere)
+    sphere = std::make_shared<UnitIcosphere>(base);
+  WriteTexcoords(*sphere);
+  return sphere;
+}
+} // namespace
+
+size_t Toybox::IcosphereVertexCount(int level) {
+  CheckLevel(level);
+  //=> seam이 지나는 vertex는 level마다 두 배가 되고, level 1부터 극점 두
+  //=> 개가 각각 복사본 4개를 더한다.
+  size_t splitCount = level == 0 ? 3 : (size_t(3) << level) + 9;
+  return (size_t(10) << (2 * level)) + 2 + splitCount;
+}
+
+size_t Toybox::IcosphereIndexCount(int level) {
+  CheckLevel(level);
+  return size_t(60) << (2 * level);
+}
+
+std::shared_ptr<const UnitIcosphere> Toybox::MakeUnitIcosphere(int level) {
+  CheckLevel(level);
+  return SubdivideFrom(*MakeIcosahedron(), 0, level);
+}
+
+namespace {
+std::mutex cacheMutex;
+std::shared_ptr<const UnitIcosphere> cachedSpheres[kMaxIcosphereLevel + 1];
+} // namespace
+
+std::shared_ptr<const UnitIcosphere> Toybox::CachedUnitIcosphere(int level) {
+  CheckLevel(level);
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  if (!cachedSpheres[level]) {
+    //=> cache된 가장 높은 아래 level에서 이어서 나누고, 중간 level도 남긴다.
+    int from = level;
+    while (from > 0 && !cachedSpheres[from - 1])
+      --from;
+    if (from == 0)
+      cachedSpheres[from++] = MakeUnitIcosphere(0);
+    for (int i = from; i <= level; ++i)
+      cachedSpheres[i] = SubdivideFrom(*cachedSpheres[i - 1], i - 1, i);
+  }
+  return cachedSpheres[level];
+}
+
+std::shared_ptr<const UnitIcosphere>
+Toybox::FindCachedUnitIcosphere(int level) {
+  CheckLevel(level);
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  return cachedSpheres[level];
+}
+
+void Toybox::ReleaseUnitIcospheres() {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  for (auto &sphere : cachedSpheres)
+    sphere.reset();
+}
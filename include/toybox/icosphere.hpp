@@ -0,0 +1,49 @@
+#ifndef TOYBOX_ICOSPHERE_H
+#define TOYBOX_ICOSPHERE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Toybox {
+
+//! 정이십면체를 level번 나눈 반지름 1의 구. normal은 position과 같다.
+//! 앞의 sharedCount개 vertex는 인접 삼각형이 공유한다. 그 뒤의 vertex는
+//! texture seam과 극점에서 나눈 복사본이며, splitSources가 원본 번호이다.
+struct UnitIcosphere {
+  std::vector<float> positions; // vertex마다 3개
+  std::vector<float> texcoords; // vertex마다 2개 (경도/위도)
+  std::vector<uint32_t> indexes;
+  size_t sharedCount = 0;
+  std::vector<uint32_t> splitSources;
+};
+
+//! level 단계의 vertex / index 개수. level이 범위를 벗어나면 예외를 던진다.
+//! - vertex: 10 * 4^level + 2에 seam과 극점의 복사본을 더한다.
+//!   (level 0은 3개, 그 외에는 3 * 2^level + 9개)
+//! - index: 60 * 4^level
+size_t IcosphereVertexCount(int level);
+size_t IcosphereIndexCount(int level);
+
+//! 단위 icosphere를 새로 만든다.
+//! level마다 삼각형 하나를 4개로 나누며, edge 중점은 hash table로 한 번만
+//! 만들어 양쪽 삼각형이 공유한다.
+std::shared_ptr<const UnitIcosphere> MakeUnitIcosphere(int level);
+
+//! level별로 한 번만 만들어 process 전체에서 공유하는 단위 icosphere.
+//! 없으면 cache된 아래 level에서 이어서 나눈다. 여러 thread에서 호출해도
+//! 안전하며, 만든 구는 ReleaseUnitIcospheres를 호출할 때까지 유지된다.
+//! (level 10은 아래 level을 포함해 약 600MB를 차지한다)
+std::shared_ptr<const UnitIcosphere> CachedUnitIcosphere(int level);
+
+//! level이 이미 cache되어 있으면 그 구를, 아니면 nullptr를 반환한다.
+//! 새로 만들지 않는다.
+std::shared_ptr<const UnitIcosphere> FindCachedUnitIcosphere(int level);
+
+//! cache된 단위 icosphere를 모두 놓는다. 이미 받은 shared_ptr은 계속
+//! 유효하며, 다음 CachedUnitIcosphere 호출에서 다시 만든다.
+void ReleaseUnitIcospheres();
+} // namespace Toybox
+
+#endif
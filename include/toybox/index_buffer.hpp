@@ -0,0 +1,117 @@
+#ifndef TOYBOX_INDEX_BUFFER_H
+#define TOYBOX_INDEX_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <toybox/vertex.hpp>
+#include <vector>
+
+namespace Toybox {
+
+enum IndexTypeEnum { INDEX_UINT16, INDEX_UINT32 };
+
+//! vertex 개수에 따라 16bit / 32bit 형식을 고르는 index 저장소.
+//! vertex가 65536개 이하이면 uint16_t로 저장해 메모리와 upload 크기를 줄인다.
+class IndexBuffer {
+public:
+  //! uint16_t로 표현할 수 있는 최대 vertex 개수
+  static constexpr size_t kMaxUInt16VertexCount = 65536;
+
+  static IndexTypeEnum SelectType(size_t vertexCount) {
+    return vertexCount <= kMaxUInt16VertexCount ? INDEX_UINT16 : INDEX_UINT32;
+  }
+
+  IndexBuffer() : type(INDEX_UINT16) {}
+
+  //! vertexCount에 맞는 형식을 고르고 indexCount개 공간을 확보한다.
+  void Resize(size_t vertexCount, size_t indexCount) {
+    type = SelectType(vertexCount);
+    if (type == INDEX_UINT16) {
+      indexes32.clear();
+      indexes32.shrink_to_fit();
+      indexes16.resize(indexCount);
+    } else {
+      indexes16.clear();
+      indexes16.shrink_to_fit();
+      indexes32.resize(indexCount);
+    }
+  }
+
+  IndexTypeEnum Type() const { return type; }
+  size_t size() const {
+    return type == INDEX_UINT16 ? indexes16.size() : indexes32.size();
+  }
+  bool empty() const { return size() == 0; }
+
+  //! index 한 개의 크기 (byte)
+  size_t ElementSize() const {
+    return type == INDEX_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+  }
+  size_t ByteSize() const { return size() * ElementSize(); }
+
+  //! GPU upload 용도의 원본 메모리. 형식은 Type()으로 확인한다.
+  const void *data() const {
+    return type == INDEX_UINT16 ? static_cast<const void *>(indexes16.data())
+                                : static_cast<const void *>(indexes32.data());
+  }
+
+  //! 형식이 맞지 않으면 nullptr을 반환한다.
+  uint16_t *Data16() {
+    return type == INDEX_UINT16 ? indexes16.data() : nullptr;
+  }
+  const uint16_t *Data16() const {
+    return type == INDEX_UINT16 ? indexes16.data() : nullptr;
+  }
+  uint32_t *Data32() {
+    return type == INDEX_UINT32 ? indexes32.data() : nullptr;
+  }
+  const uint32_t *Data32() const {
+    return type == INDEX_UINT32 ? indexes32.data() : nullptr;
+  }
+
+  uint32_t operator[](size_t i) const {
+    return type == INDEX_UINT16 ? indexes16[i] : indexes32[i];
+  }
+  void Set(size_t i, uint32_t value) {
+    if (type == INDEX_UINT16)
+      indexes16[i] = uint16_t(value);
+    else
+      indexes32[i] = value;
+  }
+
+  std::vector<uint32_t> ToUInt32() const {
+    if (type == INDEX_UINT32)
+      return indexes32;
+    return std::vector<uint32_t>(indexes16.begin(), indexes16.end());
+  }
+
+private:
+  IndexTypeEnum type;
+  std::vector<uint16_t> indexes16;
+  std::vector<uint32_t> indexes32;
+};
+
+//! index를 IndexBuffer로 저장하는 Mesh
+struct CompactMesh {
+  std::vector<Vertex> vertexes;
+  IndexBuffer indexes;
+};
+
+inline CompactMesh ToCompact(const Mesh &mesh) {
+  CompactMesh result;
+  result.vertexes = mesh.vertexes;
+  result.indexes.Resize(mesh.vertexes.size(), mesh.indexes.size());
+  for (size_t i = 0; i < mesh.indexes.size(); ++i)
+    result.indexes.Set(i, mesh.indexes[i]);
+  return result;
+}
+
+inline Mesh ToMesh(const CompactMesh &mesh) {
+  Mesh result;
+  result.vertexes = mesh.vertexes;
+  result.indexes = mesh.indexes.ToUInt32();
+  return result;
+}
+} // namespace Toybox
+
+#endif
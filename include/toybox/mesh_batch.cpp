@@ -0,0 +1,175 @@
+#include "toybox/mesh_batch.hpp"
+#include "toybox/profiler.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+using namespace Toybox;
+
+//> Transform
+Transform Transform::Identity() {
+  return Transform{{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0}};
+}
+
+Transform Transform::Translation(float x, float y, float z) {
+  return Transform{{1, 0, 0, x, 0, 1, 0, y, 0, 0, 1, z}};
+}
+
+Transform Transform::Scaling(float x, float y, float z) {
+  return Transform{{x, 0, 0, 0, 0, y, 0, 0, 0, 0, z, 0}};
+}
+
+Transform Transform::Rotation(float axisX, float axisY, float axisZ,
+                              float radians) {
+  float length = std::sqrt(axisX * axisX + axisY * axisY + axisZ * axisZ);
+  if (length == 0.0f)
+    return Identity();
+  float x = axisX / length, y = axisY / length, z = axisZ / length;
+  float c = std::cos(radians), s = std::sin(radians), t = 1.0f - c;
+  return Transform{{t * x * x + c, t * x * y - s * z, t * x * z + s * y, 0,
+                    t * x * y + s * z, t * y * y + c, t * y * z - s * x, 0,
+                    t * x * z - s * y, t * y * z + s * x, t * z * z + c, 0}};
+}
+
+namespace Toybox {
+Transform operator*(const Transform &a, const Transform &b) {
+  Transform result;
+  for (int row = 0; row < 3; ++row) {
+    const float *ar = &a.m[row * 4];
+    for (int col = 0; col < 4; ++col)
+      result.m[row * 4 + col] = ar[0] * b.m[col] + ar[1] * b.m[4 + col] +
+                                ar[2] * b.m[8 + col];
+    result.m[row * 4 + 3] += ar[3];
+  }
+  return result;
+}
+} // namespace Toybox
+
+namespace {
+//! mesh 하나를 변환해 out 뒤에 붙인다.
+void AppendTransformed(const Mesh &mesh, const Transform &transform,
+                       Mesh &out) {
+  const float *m = transform.m;
+
+  //=> normal 변환 행렬: 3x3 행렬의 여인수 행렬(= det * 역전치)에 det의
+  //=> 부호를 곱한다. 정규화하므로 크기는 상관없다.
+  float cof[9] = {m[5] * m[10] - m[6] * m[9], m[6] * m[8] - m[4] * m[10],
+                  m[4] * m[9] - m[5] * m[8],  m[2] * m[9] - m[1] * m[10],
+                  m[0] * m[10] - m[2] * m[8], m[1] * m[8] - m[0] * m[9],
+                  m[1] * m[6] - m[2] * m[5],  m[2] * m[4] - m[0] * m[6],
+                  m[0] * m[5] - m[1] * m[4]};
+  float det = m[0] * cof[0] + m[1] * cof[1] + m[2] * cof[2];
+  if (det < 0.0f)
+    for (auto &value : cof)
+      value = -value;
+
+  size_t baseVertex = out.vertexes.size();
+  out.vertexes.resize(baseVertex + mesh.vertexes.size());
+  Vertex *dst = out.vertexes.data() + baseVertex;
+  for (const Vertex &v : mesh.vertexes) {
+    *dst = v;
+    dst->x = m[0] * v.x + m[1] * v.y + m[2] * v.z + m[3];
+    dst->y = m[4] * v.x + m[5] * v.y + m[6] * v.z + m[7];
+    dst->z = m[8] * v.x + m[9] * v.y + m[10] * v.z + m[11];
+
+    float nx = cof[0] * v.nx + cof[1] * v.ny + cof[2] * v.nz;
+    float ny = cof[3] * v.nx + cof[4] * v.ny + cof[5] * v.nz;
+    float nz = cof[6] * v.nx + cof[7] * v.ny + cof[8] * v.nz;
+    float lengthSq = nx * nx + ny * ny + nz * nz;
+    float scale = lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+    dst->nx = nx * scale;
+    dst->ny = ny * scale;
+    dst->nz = nz * scale;
+    ++dst;
+  }
+
+  //=> 반사 변환이면 winding이 뒤집히므로 두 index를 바꿔 되돌린다.
+  uint32_t base = uint32_t(baseVertex);
+  size_t firstIndex = out.indexes.size();
+  out.indexes.resize(firstIndex + mesh.indexes.size());
+  uint32_t *index = out.indexes.data() + firstIndex;
+  size_t triangleEnd = mesh.indexes.size() / 3 * 3;
+  if (det < 0.0f) {
+    for (size_t i = 0; i < triangleEnd; i += 3, index += 3) {
+      index[0] = mesh.indexes[i] + base;
+      index[1] = mesh.indexes[i + 2] + base;
+      index[2] = mesh.indexes[i + 1] + base;
+    }
+    for (size_t i = triangleEnd; i < mesh.indexes.size(); ++i)
+      *index++ = mesh.indexes[i] + base;
+  } else {
+    for (uint32_t source : mesh.indexes)
+      *index++ = source + base;
+  }
+}
+
+void CheckVertexCount(size_t vertexCount) {
+  if (vertexCount > size_t(UINT32_MAX))
+    throw std::runtime_error("합친 vertex 수가 uint32_t 범위를 넘습니다.");
+}
+} // namespace
+
+//> MeshBatch
+void MeshBatch::Reserve(size_t vertexCount, size_t indexCount) {
+  merged.vertexes.reserve(merged.vertexes.size() + vertexCount);
+  merged.indexes.reserve(merged.indexes.size() + indexCount);
+}
+
+size_t MeshBatch::Add(const Mesh &mesh, const Transform &transform) {
+  CheckVertexCount(merged.vertexes.size() + mesh.vertexes.size());
+
+  SubmeshRange range;
+  range.baseVertex = uint32_t(merged.vertexes.size());
+  range.vertexCount = uint32_t(mesh.vertexes.size());
+  range.firstIndex = uint32_t(merged.indexes.size());
+  range.indexCount = uint32_t(mesh.indexes.size());
+
+  AppendTransformed(mesh, transform, merged);
+  submeshes.push_back(range);
+  return submeshes.size() - 1;
+}
+
+size_t MeshBatch::Add(const Mesh &mesh) {
+  return Add(mesh, Transform::Identity());
+}
+
+void MeshBatch::Add(Span<const BatchInstance> instances) {
+  size_t vertexCount = 0;
+  size_t indexCount = 0;
+  for (const auto &instance : instances) {
+    vertexCount += instance.mesh->vertexes.size();
+    indexCount += instance.mesh->indexes.size();
+  }
+  CheckVertexCount(merged.vertexes.size() + vertexCount);
+
+  Reserve(vertexCount, indexCount);
+  submeshes.reserve(submeshes.size() + instances.size());
+  for (const auto &instance : instances)
+    Add(*instance.mesh, instance.transform);
+}
+
+Mesh MeshBatch::Build(Span<const BatchInstance> instances,
+                      std::vector<SubmeshRange> *submeshes) {
+  TOYBOX_PROFILE_SCOPE(profile, "MeshBatch::Build");
+  MeshBatch batch;
+  batch.Add(instances);
+  if (submeshes != nullptr)
+    *submeshes = std::move(batch.submeshes);
+  Mesh merged = batch.Release();
+  TOYBOX_PROFILE_OUTPUT(profile, merged.vertexes.size(), merged.indexes.size(),
+                        merged.vertexes.size() * sizeof(Vertex) +
+                            merged.indexes.size() * sizeof(uint32_t));
+  return merged;
+}
+
+Mesh MeshBatch::Release() {
+  Mesh result = std::move(merged);
+  Clear();
+  return result;
+}
+
+void MeshBatch::Clear() {
+  merged.vertexes.clear();
+  merged.indexes.clear();
+  submeshes.clear();
+}
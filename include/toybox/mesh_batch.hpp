@@ -0,0 +1,78 @@
+#ifndef TOYBOX_MESH_BATCH_H
+#define TOYBOX_MESH_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <toybox/span.hpp>
+#include <toybox/vertex.hpp>
+#include <vector>
+
+namespace Toybox {
+
+//! 3x4 affine 변환 (row-major). p' = M * p + t
+//! m[0..2], m[4..6], m[8..10]은 3x3 행렬, m[3], m[7], m[11]은 이동량이다.
+struct Transform {
+  float m[12];
+
+  static Transform Identity();
+  static Transform Translation(float x, float y, float z);
+  static Transform Scaling(float x, float y, float z);
+  //! (axisX, axisY, axisZ) 축 기준 radians만큼 회전. 축은 정규화된다.
+  static Transform Rotation(float axisX, float axisY, float axisZ,
+                            float radians);
+
+  //! (a * b)(p) = a(b(p))
+  friend Transform operator*(const Transform &a, const Transform &b);
+};
+
+//! 합쳐진 buffer 안에서 원래 mesh 하나가 차지하는 범위
+//! index는 이미 전체 vertex 기준으로 바뀌어 있으므로 baseVertex 없이
+//! (firstIndex, indexCount)만으로 그릴 수 있다.
+struct SubmeshRange {
+  uint32_t baseVertex;
+  uint32_t vertexCount;
+  uint32_t firstIndex;
+  uint32_t indexCount;
+};
+
+//! 합칠 mesh와 적용할 변환
+struct BatchInstance {
+  const Mesh *mesh;
+  Transform transform;
+};
+
+//! 작은 Mesh 여러 개를 변환을 적용해 하나의 vertex / index buffer로 합친다.
+//! - position은 변환하고, normal은 역전치 행렬로 변환한 뒤 정규화한다.
+//! - 반사 변환(행렬식 < 0)은 삼각형 winding을 뒤집어 앞면을 유지한다.
+//! - submesh 범위는 multi-draw 호출에 그대로 사용할 수 있다.
+class MeshBatch {
+public:
+  //! 추가할 vertex / index 수만큼 미리 공간을 확보한다.
+  void Reserve(size_t vertexCount, size_t indexCount);
+
+  //! mesh를 추가하고 submesh 번호를 반환한다.
+  size_t Add(const Mesh &mesh, const Transform &transform);
+  size_t Add(const Mesh &mesh);
+
+  //! 입력 전체의 크기로 한 번 공간을 확보한 뒤 차례로 추가한다.
+  void Add(Span<const BatchInstance> instances);
+
+  //! 합쳐진 vertex 수가 uint32_t index 범위를 넘으면 예외를 던진다.
+  static Mesh Build(Span<const BatchInstance> instances,
+                    std::vector<SubmeshRange> *submeshes = nullptr);
+
+  const Mesh &Merged() const { return merged; }
+  const std::vector<SubmeshRange> &Submeshes() const { return submeshes; }
+  size_t SubmeshCount() const { return submeshes.size(); }
+
+  //! 합쳐진 Mesh를 넘겨주고 builder를 비운다.
+  Mesh Release();
+  void Clear();
+
+private:
+  Mesh merged;
+  std::vector<SubmeshRange> submeshes;
+};
+} // namespace Toybox
+
+#endif
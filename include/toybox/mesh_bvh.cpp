@@ -0,0 +1,378 @@
+#include "toybox/mesh_bvh.hpp"
+#include "toybox/profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+using namespace Toybox;
+
+namespace {
+//! 이보다 깊어지면 leaf로 만든다. 검색 stack 크기와 같다.
+constexpr int kMaxDepth = 64;
+//! 이보다 삼각형이 많은 하위 tree는 병렬로 만든다.
+constexpr size_t kParallelThreshold = 16 * 1024;
+
+struct Aabb {
+  float min[3] = {INFINITY, INFINITY, INFINITY};
+  float max[3] = {-INFINITY, -INFINITY, -INFINITY};
+
+  void Grow(const float *p) {
+    for (int a = 0; a < 3; ++a) {
+      min[a] = std::min(min[a], p[a]);
+      max[a] = std::max(max[a], p[a]);
+    }
+  }
+  void Grow(const Aabb &box) {
+    for (int a = 0; a < 3; ++a) {
+      min[a] = std::min(min[a], box.min[a]);
+      max[a] = std::max(max[a], box.max[a]);
+    }
+  }
+  //! 표면적의 절반. SAH 비교에는 비율만 필요하다.
+  float HalfArea() const {
+    float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+    return dx < 0.0f ? 0.0f : dx * dy + dy * dz + dz * dx;
+  }
+};
+
+void Sub(const float *a, const float *b, float *out) {
+  out[0] = a[0] - b[0], out[1] = a[1] - b[1], out[2] = a[2] - b[2];
+}
+
+void Cross(const float *a, const float *b, float *out) {
+  out[0] = a[1] * b[2] - a[2] * b[1];
+  out[1] = a[2] * b[0] - a[0] * b[2];
+  out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+float Dot(const float *a, const float *b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+//! 삼각형별 bounds와 중심점, 그리고 정렬 대상인 삼각형 번호
+struct BuildContext {
+  std::vector<Aabb> bounds;
+  std::vector<float> centroids; // 삼각형마다 3개
+  std::vector<uint32_t> order;
+  BvhBuildParams params;
+  ThreadPool *pool;
+};
+
+//! 내부 node의 offset(오른쪽 자식 번호)에 base를 더해 out 뒤에 붙인다.
+void AppendSubtree(const std::vector<BvhNode> &subtree, uint32_t base,
+                   std::vector<BvhNode> &out) {
+  for (BvhNode node : subtree) {
+    if (!node.IsLeaf())
+      node.offset += base;
+    out.push_back(node);
+  }
+}
+
+//! order[begin, end) 범위의 하위 tree를 out 뒤에 붙인다.
+void BuildNode(BuildContext &ctx, size_t begin, size_t end, int depth,
+               std::vector<BvhNode> &out) {
+  Aabb nodeBounds, centroidBounds;
+  for (size_t i = begin; i < end; ++i) {
+    uint32_t triangle = ctx.order[i];
+    nodeBounds.Grow(ctx.bounds[triangle]);
+    centroidBounds.Grow(&ctx.centroids[size_t(triangle) * 3]);
+  }
+
+  const uint32_t nodeIndex = uint32_t(out.size());
+  {
+    BvhNode node;
+    std::copy(nodeBounds.min, nodeBounds.min + 3, node.boundsMin);
+    std::copy(nodeBounds.max, nodeBounds.max + 3, node.boundsMax);
+    node.offset = uint32_t(begin);
+    node.count = uint32_t(end - begin);
+    out.push_back(node);
+  }
+
+  const size_t count = end - begin;
+  if (count <= ctx.params.maxLeafSize || depth + 1 >= kMaxDepth)
+    return;
+
+  //> binned SAH: 축마다 중심점을 bin에 나누고, bin 경계 중 비용이 가장 작은
+  //> 곳에서 나눈다. 비용 = 왼쪽 면적 * 왼쪽 개수 + 오른쪽 면적 * 오른쪽 개수
+  const uint32_t binCount = std::max<uint32_t>(ctx.params.binCount, 2);
+  std::vector<Aabb> binBounds(binCount);
+  std::vector<size_t> binSizes(binCount);
+  std::vector<float> rightCosts(binCount);
+
+  float bestCost = INFINITY;
+  int bestAxis = -1;
+  uint32_t bestBin = 0;
+  for (int axis = 0; axis < 3; ++axis) {
+    float axisMin = centroidBounds.min[axis];
+    float extent = centroidBounds.max[axis] - axisMin;
+    if (!(extent > 0.0f))
+      continue;
+    float scale = binCount / extent;
+
+    std::fill(binBounds.begin(), binBounds.end(), Aabb());
+    std::fill(binSizes.begin(), binSizes.end(), 0);
+    for (size_t i = begin; i < end; ++i) {
+      uint32_t triangle = ctx.order[i];
+      float c = ctx.centroids[size_t(triangle) * 3 + axis];
+      uint32_t bin = std::min(binCount - 1, uint32_t((c - axisMin) * scale));
+      binBounds[bin].Grow(ctx.bounds[triangle]);
+      ++binSizes[bin];
+    }
+
+    Aabb right;
+    size_t rightSize = 0;
+    for (uint32_t bin = binCount - 1; bin > 0; --bin) {
+      right.Grow(binBounds[bin]);
+      rightSize += binSizes[bin];
+      rightCosts[bin] = right.HalfArea() * float(rightSize);
+    }
+    Aabb left;
+    size_t leftSize = 0;
+    for (uint32_t bin = 0; bin + 1 < binCount; ++bin) {
+      left.Grow(binBounds[bin]);
+      leftSize += binSizes[bin];
+      if (leftSize == 0 || leftSize == count)
+        continue;
+      float cost = left.HalfArea() * float(leftSize) + rightCosts[bin + 1];
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestAxis = axis;
+        bestBin = bin;
+      }
+    }
+  }
+  //=> 모든 중심점이 같으면 나누어도 이득이 없으므로 leaf로 둔다.
+  if (bestAxis < 0)
+    return;
+
+  float axisMin = centroidBounds.min[bestAxis];
+  float scale = binCount / (centroidBounds.max[bestAxis] - axisMin);
+  auto middle = std::partition(
+      ctx.order.begin() + begin, ctx.order.begin() + end,
+      [&](uint32_t triangle) {
+        float c = ctx.centroids[size_t(triangle) * 3 + bestAxis];
+        return std::min(binCount - 1, uint32_t((c - axisMin) * scale)) <=
+               bestBin;
+      });
+  size_t split = size_t(middle - ctx.order.begin());
+
+  out[nodeIndex].count = 0;
+  if (ctx.pool != nullptr && count >= kParallelThreshold) {
+    //=> 두 하위 tree는 order의 겹치지 않는 구간만 바꾸므로 동시에 만들 수
+    //=> 있다. 각자 0번부터 번호를 매긴 뒤 깊이 우선 순서로 이어 붙인다.
+    std::vector<BvhNode> leftNodes, rightNodes;
+    ctx.pool->Run(
+        {[&]() { BuildNode(ctx, begin, split, depth + 1, leftNodes); },
+         [&]() { BuildNode(ctx, split, end, depth + 1, rightNodes); }});
+    uint32_t leftBase = nodeIndex + 1;
+    uint32_t rightBase = leftBase + uint32_t(leftNodes.size());
+    out.reserve(out.size() + leftNodes.size() + rightNodes.size());
+    AppendSubtree(leftNodes, leftBase, out);
+    AppendSubtree(rightNodes, rightBase, out);
+    out[nodeIndex].offset = rightBase;
+  } else {
+    BuildNode(ctx, begin, split, depth + 1, out);
+    out[nodeIndex].offset = uint32_t(out.size());
+    BuildNode(ctx, split, end, depth + 1, out);
+  }
+}
+
+//! ray가 node bounds와 만나는 가장 가까운 t. 만나지 않으면 INFINITY.
+inline float IntersectBounds(const BvhNode &node, const float *origin,
+                             const float *invDirection, float tMin,
+                             float tMax) {
+  for (int a = 0; a < 3; ++a) {
+    float t0 = (node.boundsMin[a] - origin[a]) * invDirection[a];
+    float t1 = (node.boundsMax[a] - origin[a]) * invDirection[a];
+    if (t0 > t1)
+      std::swap(t0, t1);
+    tMin = t0 > tMin ? t0 : tMin;
+    tMax = t1 < tMax ? t1 : tMax;
+  }
+  return tMin <= tMax ? tMin : INFINITY;
+}
+
+//! Möller–Trumbore 교차 검사. 양면 모두 교차로 본다.
+inline bool IntersectTriangle(const float *p0, const float *p1,
+                              const float *p2, const Ray &ray, float tMax,
+                              float &t, float &u, float &v) {
+  float e1[3], e2[3], pv[3], tv[3], qv[3];
+  Sub(p1, p0, e1);
+  Sub(p2, p0, e2);
+  Cross(ray.direction, e2, pv);
+  float det = Dot(e1, pv);
+  if (det == 0.0f)
+    return false;
+  float invDet = 1.0f / det;
+
+  Sub(ray.origin, p0, tv);
+  u = Dot(tv, pv) * invDet;
+  if (u < 0.0f || u > 1.0f)
+    return false;
+  Cross(tv, e1, qv);
+  v = Dot(ray.direction, qv) * invDet;
+  if (v < 0.0f || u + v > 1.0f)
+    return false;
+  t = Dot(e2, qv) * invDet;
+  return t >= ray.tMin && t <= tMax;
+}
+} // namespace
+
+//> 생성
+void MeshBvh::Build(const Mesh &mesh, const BvhBuildParams &params) {
+  BuildTree(mesh, nullptr, params);
+}
+
+void MeshBvh::Build(const Mesh &mesh, ThreadPool &pool,
+                    const BvhBuildParams &params) {
+  BuildTree(mesh, &pool, params);
+}
+
+void MeshBvh::BuildTree(const Mesh &mesh, ThreadPool *pool,
+                        const BvhBuildParams &params) {
+  TOYBOX_PROFILE_SCOPE(profile, "MeshBvh::Build");
+  const size_t triangleCount = mesh.indexes.size() / 3;
+  if (triangleCount > size_t(UINT32_MAX))
+    throw std::runtime_error("삼각형 수가 uint32_t 범위를 넘습니다.");
+
+  BuildContext ctx;
+  ctx.params = params;
+  ctx.pool = pool;
+  ctx.bounds.resize(triangleCount);
+  ctx.centroids.resize(triangleCount * 3);
+  ctx.order.resize(triangleCount);
+  for (size_t t = 0; t < triangleCount; ++t) {
+    Aabb &box = ctx.bounds[t];
+    for (int k = 0; k < 3; ++k) {
+      const Vertex &vertex = mesh.vertexes.at(mesh.indexes[t * 3 + k]);
+      const float position[3] = {vertex.x, vertex.y, vertex.z};
+      box.Grow(position);
+    }
+    for (int a = 0; a < 3; ++a)
+      ctx.centroids[t * 3 + a] = 0.5f * (box.min[a] + box.max[a]);
+    ctx.order[t] = uint32_t(t);
+  }
+
+  nodes.clear();
+  if (triangleCount > 0) {
+    uint32_t leafSize = std::max<uint32_t>(params.maxLeafSize, 1);
+    nodes.reserve(triangleCount * 2 / leafSize);
+    BuildNode(ctx, 0, triangleCount, 0, nodes);
+  }
+  nodes.shrink_to_fit();
+  triangleIds = std::move(ctx.order);
+  Refit(mesh);
+  TOYBOX_PROFILE_OUTPUT(profile, mesh.vertexes.size(), mesh.indexes.size(),
+                        nodes.size() * sizeof(nodes[0]) +
+                            triangleIds.size() * sizeof(uint32_t));
+}
+
+void MeshBvh::Refit(const Mesh &mesh) {
+  if (mesh.indexes.size() / 3 != triangleIds.size())
+    throw std::runtime_error("BVH와 Mesh의 삼각형 수가 다릅니다.");
+
+  triangles.resize(triangleIds.size());
+  for (size_t i = 0; i < triangleIds.size(); ++i) {
+    const uint32_t *tri = &mesh.indexes[size_t(triangleIds[i]) * 3];
+    float *points[3] = {triangles[i].p0, triangles[i].p1, triangles[i].p2};
+    for (int k = 0; k < 3; ++k) {
+      const Vertex &vertex = mesh.vertexes.at(tri[k]);
+      points[k][0] = vertex.x;
+      points[k][1] = vertex.y;
+      points[k][2] = vertex.z;
+    }
+  }
+
+  //=> 자식은 항상 부모보다 뒤에 있으므로 뒤에서부터 계산하면 된다.
+  for (size_t n = nodes.size(); n-- > 0;) {
+    BvhNode &node = nodes[n];
+    Aabb box;
+    if (node.IsLeaf()) {
+      for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+        box.Grow(triangles[i].p0);
+        box.Grow(triangles[i].p1);
+        box.Grow(triangles[i].p2);
+      }
+    } else {
+      for (const BvhNode *child : {&nodes[n + 1], &nodes[node.offset]}) {
+        box.Grow(child->boundsMin);
+        box.Grow(child->boundsMax);
+      }
+    }
+    std::copy(box.min, box.min + 3, node.boundsMin);
+    std::copy(box.max, box.max + 3, node.boundsMax);
+  }
+}
+
+//> 검색
+bool MeshBvh::Intersect(const Ray &ray, RayHit &hit) const {
+  return Traverse<false>(ray, hit);
+}
+
+bool MeshBvh::Occluded(const Ray &ray) const {
+  RayHit hit;
+  return Traverse<true>(ray, hit);
+}
+
+template <bool AnyHit>
+bool MeshBvh::Traverse(const Ray &ray, RayHit &hit) const {
+  if (nodes.empty())
+    return false;
+
+  const float invDirection[3] = {1.0f / ray.direction[0],
+                                 1.0f / ray.direction[1],
+                                 1.0f / ray.direction[2]};
+  float closest = ray.tMax;
+  bool found = false;
+
+  uint32_t stack[kMaxDepth];
+  int stackSize = 0;
+  if (IntersectBounds(nodes[0], ray.origin, invDirection, ray.tMin,
+                      closest) == INFINITY)
+    return false;
+  uint32_t current = 0;
+
+  while (true) {
+    const BvhNode &node = nodes[current];
+    if (node.IsLeaf()) {
+      for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+        const Triangle &tri = triangles[i];
+        float t, u, v;
+        if (!IntersectTriangle(tri.p0, tri.p1, tri.p2, ray, closest, t, u, v))
+          continue;
+        found = true;
+        closest = t;
+        hit = RayHit{triangleIds[i], t, u, v};
+        if (AnyHit)
+          return true;
+      }
+    } else {
+      //=> 가까운 자식을 먼저 방문하고 먼 자식은 stack에 넣는다.
+      uint32_t near = current + 1, far = node.offset;
+      float tNear = IntersectBounds(nodes[near], ray.origin, invDirection,
+                                    ray.tMin, closest);
+      float tFar = IntersectBounds(nodes[far], ray.origin, invDirection,
+                                   ray.tMin, closest);
+      if (tFar < tNear) {
+        std::swap(near, far);
+        std::swap(tNear, tFar);
+      }
+      if (tNear != INFINITY) {
+        if (tFar != INFINITY)
+          stack[stackSize++] = far;
+        current = near;
+        continue;
+      }
+    }
+
+    //> 다음 node: stack에서 꺼내되, 이미 찾은 교차보다 먼 node는 건너뛴다.
+    do {
+      if (stackSize == 0)
+        return found;
+      current = stack[--stackSize];
+    } while (!AnyHit && IntersectBounds(nodes[current], ray.origin,
+                                        invDirection, ray.tMin,
+                                        closest) == INFINITY);
+  }
+}
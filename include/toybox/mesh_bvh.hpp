@@ -0,0 +1,88 @@
+#ifndef TOYBOX_MESH_BVH_H
+#define TOYBOX_MESH_BVH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <toybox/thread_pool.hpp>
+#include <toybox/vertex.hpp>
+#include <vector>
+
+namespace Toybox {
+
+//! origin + t * direction, t는 [tMin, tMax] 범위만 검사한다.
+//! direction은 정규화하지 않아도 된다. (t는 direction 길이 단위)
+struct Ray {
+  float origin[3];
+  float direction[3];
+  float tMin = 0.0f;
+  float tMax = std::numeric_limits<float>::infinity();
+};
+
+//! 가장 가까운 교차 결과
+struct RayHit {
+  uint32_t triangle; // Mesh.indexes 기준 삼각형 번호 (index / 3)
+  float t;
+  float u; // barycentric 좌표: 교차점 = (1 - u - v) * p0 + u * p1 + v * p2
+  float v;
+};
+
+//! 32 byte node. 자식은 깊이 우선 순서로 배치되어 왼쪽 자식은 항상 바로 다음
+//! node이다.
+//! - 내부 node: count == 0, offset = 오른쪽 자식 번호
+//! - leaf node: count > 0, offset = 첫 삼각형의 정렬된 번호
+struct BvhNode {
+  float boundsMin[3];
+  uint32_t offset;
+  float boundsMax[3];
+  uint32_t count;
+
+  bool IsLeaf() const { return count > 0; }
+};
+
+struct BvhBuildParams {
+  uint32_t binCount = 16;   // SAH 분할 후보 개수 (축마다)
+  uint32_t maxLeafSize = 4; // leaf 하나에 들어가는 최대 삼각형 수
+};
+
+//! Mesh 삼각형에 대한 bounding volume hierarchy
+//! binned SAH로 분할하며, 삼각형 좌표를 leaf 순서로 복사해 두므로 검색 중에는
+//! Mesh에 접근하지 않는다.
+class MeshBvh {
+public:
+  void Build(const Mesh &mesh, const BvhBuildParams &params = {});
+  //! 큰 하위 tree를 pool에서 병렬로 만든다. 결과 구조는 단일 thread와 같다.
+  void Build(const Mesh &mesh, ThreadPool &pool,
+             const BvhBuildParams &params = {});
+
+  //! 삼각형 구성은 그대로이고 vertex 위치만 바뀌었을 때 bounds만 다시
+  //! 계산한다. 분할은 유지되므로 변형이 크면 Build가 더 빠를 수 있다.
+  void Refit(const Mesh &mesh);
+
+  //! 가장 가까운 교차를 찾는다. 없으면 false.
+  bool Intersect(const Ray &ray, RayHit &hit) const;
+  //! [tMin, tMax] 안에 교차가 하나라도 있는지 검사한다. (그림자, 가시성)
+  bool Occluded(const Ray &ray) const;
+
+  const std::vector<BvhNode> &Nodes() const { return nodes; }
+  size_t TriangleCount() const { return triangleIds.size(); }
+
+private:
+  struct Triangle {
+    float p0[3];
+    float p1[3];
+    float p2[3];
+  };
+
+  void BuildTree(const Mesh &mesh, ThreadPool *pool,
+                 const BvhBuildParams &params);
+  template <bool AnyHit>
+  bool Traverse(const Ray &ray, RayHit &hit) const;
+
+  std::vector<BvhNode> nodes;
+  std::vector<uint32_t> triangleIds; // leaf 순서 -> Mesh 삼각형 번호
+  std::vector<Triangle> triangles;   // leaf 순서의 삼각형 좌표
+};
+} // namespace Toybox
+
+#endif
@@ -0,0 +1,280 @@
+#include "toybox/mesh_file.hpp"
+#include "toybox/vertex_layout.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Toybox;
+
+static_assert(sizeof(MeshFileHeader) == 88,
+              "MeshFileHeader 크기가 바뀌면 version을 올려야 합니다.");
+
+namespace {
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t IndexStride(IndexTypeEnum type) {
+  return type == INDEX_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+//! header가 파일 크기, 정렬 조건과 맞는지 검사한다.
+void ValidateHeader(const MeshFileHeader &header, size_t fileSize) {
+  if (header.magic != MeshFileHeader::kMagic)
+    throw std::runtime_error("Mesh 파일 형식이 아닙니다.");
+  if (header.endianTag != MeshFileHeader::kEndianTag)
+    throw std::runtime_error("Mesh 파일의 byte order가 다릅니다.");
+  if (header.version != MeshFileHeader::kVersion ||
+      header.headerSize != sizeof(MeshFileHeader))
+    throw std::runtime_error("지원하지 않는 Mesh 파일 version입니다.");
+  if (header.vertexStride != sizeof(Vertex) ||
+      (header.indexType != INDEX_UINT16 && header.indexType != INDEX_UINT32) ||
+      header.indexStride != IndexStride(IndexTypeEnum(header.indexType)))
+    throw std::runtime_error("지원하지 않는 vertex / index 형식입니다.");
+
+  auto fits = [fileSize](uint64_t offset, uint64_t count, uint64_t stride) {
+    return offset % MeshFileHeader::kStreamAlignment == 0 &&
+           offset <= fileSize && count <= (fileSize - offset) / stride;
+  };
+  if (!fits(header.vertexOffset, header.vertexCount, header.vertexStride) ||
+      !fits(header.indexOffset, header.indexCount, header.indexStride))
+    throw std::runtime_error("Mesh 파일의 stream 범위가 잘못되었습니다.");
+}
+} // namespace
+
+//> 저장
+void MeshFileWriter::Write(const std::string &path, const Mesh &mesh) {
+  Write(path, mesh.vertexes, mesh.indexes.data(), mesh.indexes.size(),
+        INDEX_UINT32);
+}
+
+void MeshFileWriter::Write(const std::string &path, const CompactMesh &mesh) {
+  Write(path, mesh.vertexes, mesh.indexes.data(), mesh.indexes.size(),
+        mesh.indexes.Type());
+}
+
+void MeshFileWriter::Write(const std::string &path,
+                           Span<const Vertex> vertexes, const void *indexes,
+                           size_t indexCount, IndexTypeEnum indexType) {
+  MeshFileHeader header = {};
+  header.magic = MeshFileHeader::kMagic;
+  header.version = MeshFileHeader::kVersion;
+  header.endianTag = MeshFileHeader::kEndianTag;
+  header.headerSize = sizeof(MeshFileHeader);
+  header.vertexStride = sizeof(Vertex);
+  header.attributeMask = ATTR_ALL;
+  header.indexType = indexType;
+  header.indexStride = uint32_t(IndexStride(indexType));
+
+  header.vertexCount = vertexes.size();
+  header.vertexOffset =
+      AlignUp(sizeof(MeshFileHeader), MeshFileHeader::kStreamAlignment);
+  header.indexCount = indexCount;
+  header.indexOffset =
+      AlignUp(header.vertexOffset + vertexes.size() * sizeof(Vertex),
+              MeshFileHeader::kStreamAlignment);
+
+  for (int a = 0; a < 3; ++a) {
+    header.boundsMin[a] = 0.0f;
+    header.boundsMax[a] = 0.0f;
+  }
+  if (!vertexes.empty()) {
+    const Vertex &first = vertexes[0];
+    float minValue[3] = {first.x, first.y, first.z};
+    float maxValue[3] = {first.x, first.y, first.z};
+    for (const auto &v : vertexes) {
+      const float position[3] = {v.x, v.y, v.z};
+      for (int a = 0; a < 3; ++a) {
+        minValue[a] = std::min(minValue[a], position[a]);
+        maxValue[a] = std::max(maxValue[a], position[a]);
+      }
+    }
+    std::copy(minValue, minValue + 3, header.boundsMin);
+    std::copy(maxValue, maxValue + 3, header.boundsMax);
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file)
+    throw std::runtime_error("Mesh 파일을 열 수 없습니다: " + path);
+
+  //=> stream 사이의 빈 공간은 0으로 채운다.
+  const char padding[MeshFileHeader::kStreamAlignment] = {};
+  auto padTo = [&file, &padding](uint64_t offset) {
+    uint64_t position = uint64_t(file.tellp());
+    file.write(padding, std::streamsize(offset - position));
+  };
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  padTo(header.vertexOffset);
+  file.write(reinterpret_cast<const char *>(vertexes.data()),
+             std::streamsize(vertexes.size() * sizeof(Vertex)));
+  padTo(header.indexOffset);
+  file.write(static_cast<const char *>(indexes),
+             std::streamsize(indexCount * header.indexStride));
+  if (!file)
+    throw std::runtime_error("Mesh 파일을 저장하지 못했습니다: " + path);
+}
+
+//> 읽기
+MappedMesh::MappedMesh(const std::string &path) {
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    throw std::runtime_error("Mesh 파일을 열 수 없습니다: " + path);
+  fileHandle = file;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+    Close();
+    throw std::runtime_error("Mesh 파일 크기를 확인할 수 없습니다: " + path);
+  }
+  size = size_t(fileSize.QuadPart);
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    Close();
+    throw std::runtime_error("Mesh 파일을 mapping할 수 없습니다: " + path);
+  }
+  mappingHandle = mapping;
+
+  data = static_cast<const uint8_t *>(
+      MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (data == nullptr) {
+    Close();
+    throw std::runtime_error("Mesh 파일을 mapping할 수 없습니다: " + path);
+  }
+#else
+  int file = open(path.c_str(), O_RDONLY);
+  if (file < 0)
+    throw std::runtime_error("Mesh 파일을 열 수 없습니다: " + path);
+
+  struct stat status;
+  if (fstat(file, &status) != 0 || status.st_size == 0) {
+    close(file);
+    throw std::runtime_error("Mesh 파일 크기를 확인할 수 없습니다: " + path);
+  }
+  size = size_t(status.st_size);
+
+  //=> mapping은 file descriptor를 닫아도 유지된다.
+  void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);
+  if (mapped == MAP_FAILED)
+    throw std::runtime_error("Mesh 파일을 mapping할 수 없습니다: " + path);
+  data = static_cast<const uint8_t *>(mapped);
+#endif
+
+  if (size < sizeof(MeshFileHeader)) {
+    Close();
+    throw std::runtime_error("Mesh 파일 형식이 아닙니다: " + path);
+  }
+  try {
+    ValidateHeader(Header(), size);
+  } catch (...) {
+    Close();
+    throw;
+  }
+}
+
+MappedMesh::~MappedMesh() { Close(); }
+
+MappedMesh::MappedMesh(MappedMesh &&other) noexcept {
+  *this = std::move(other);
+}
+
+MappedMesh &MappedMesh::operator=(MappedMesh &&other) noexcept {
+  if (this != &other) {
+    Close();
+    std::swap(data, other.data);
+    std::swap(size, other.size);
+#if defined(_WIN32)
+    std::swap(fileHandle, other.fileHandle);
+    std::swap(mappingHandle, other.mappingHandle);
+#endif
+  }
+  return *this;
+}
+
+void MappedMesh::Close() {
+#if defined(_WIN32)
+  if (data != nullptr)
+    UnmapViewOfFile(data);
+  if (mappingHandle != nullptr)
+    CloseHandle(mappingHandle);
+  if (fileHandle != nullptr)
+    CloseHandle(fileHandle);
+  mappingHandle = nullptr;
+  fileHandle = nullptr;
+#else
+  if (data != nullptr)
+    munmap(const_cast<uint8_t *>(data), size);
+#endif
+  data = nullptr;
+  size = 0;
+}
+
+const MeshFileHeader &MappedMesh::Header() const {
+  return *reinterpret_cast<const MeshFileHeader *>(data);
+}
+
+Span<const Vertex> MappedMesh::Vertexes() const {
+  if (!IsOpen())
+    return Span<const Vertex>();
+  const MeshFileHeader &header = Header();
+  return Span<const Vertex>(
+      reinterpret_cast<const Vertex *>(data + header.vertexOffset),
+      size_t(header.vertexCount));
+}
+
+IndexTypeEnum MappedMesh::IndexType() const {
+  return IsOpen() ? IndexTypeEnum(Header().indexType) : INDEX_UINT32;
+}
+
+Span<const uint32_t> MappedMesh::Indexes32() const {
+  if (!IsOpen() || IndexType() != INDEX_UINT32)
+    return Span<const uint32_t>();
+  const MeshFileHeader &header = Header();
+  return Span<const uint32_t>(
+      reinterpret_cast<const uint32_t *>(data + header.indexOffset),
+      size_t(header.indexCount));
+}
+
+Span<const uint16_t> MappedMesh::Indexes16() const {
+  if (!IsOpen() || IndexType() != INDEX_UINT16)
+    return Span<const uint16_t>();
+  const MeshFileHeader &header = Header();
+  return Span<const uint16_t>(
+      reinterpret_cast<const uint16_t *>(data + header.indexOffset),
+      size_t(header.indexCount));
+}
+
+Mesh MappedMesh::ToMesh() const {
+  Mesh mesh;
+  Span<const Vertex> vertexes = Vertexes();
+  mesh.vertexes.assign(vertexes.begin(), vertexes.end());
+  if (IndexType() == INDEX_UINT16) {
+    Span<const uint16_t> indexes = Indexes16();
+    mesh.indexes.assign(indexes.begin(), indexes.end());
+  } else {
+    Span<const uint32_t> indexes = Indexes32();
+    mesh.indexes.assign(indexes.begin(), indexes.end());
+  }
+  return mesh;
+}
@@ -0,0 +1,97 @@
+#ifndef TOYBOX_MESH_FILE_H
+#define TOYBOX_MESH_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <toybox/index_buffer.hpp>
+#include <toybox/span.hpp>
+#include <toybox/vertex.hpp>
+
+namespace Toybox {
+
+//! Mesh binary 파일 header. 파일 맨 앞에 그대로 기록된다. (little endian)
+//! vertex / index stream은 kStreamAlignment 경계에서 시작하므로, mapping한
+//! 메모리를 복사 없이 Vertex / index 배열로 사용할 수 있다.
+struct MeshFileHeader {
+  static constexpr uint32_t kMagic = 0x464D4254; // "TBMF"
+  static constexpr uint32_t kVersion = 1;
+  static constexpr uint32_t kEndianTag = 0x01020304;
+  static constexpr uint64_t kStreamAlignment = 64;
+
+  uint32_t magic;
+  uint32_t version;
+  uint32_t endianTag;
+  uint32_t headerSize;
+
+  //=> layout
+  uint32_t vertexStride;  // sizeof(Vertex)
+  uint32_t attributeMask; // VertexAttributeEnum 조합
+  uint32_t indexType;     // IndexTypeEnum
+  uint32_t indexStride;
+
+  //=> stream 위치 (파일 시작 기준 byte)
+  uint64_t vertexCount;
+  uint64_t vertexOffset;
+  uint64_t indexCount;
+  uint64_t indexOffset;
+
+  //=> position bounds
+  float boundsMin[3];
+  float boundsMax[3];
+};
+
+//! Mesh를 binary 파일로 저장한다. 실패하면 예외를 던진다.
+//! CompactMesh는 16bit index를 그대로 저장한다.
+class MeshFileWriter {
+public:
+  static void Write(const std::string &path, const Mesh &mesh);
+  static void Write(const std::string &path, const CompactMesh &mesh);
+
+private:
+  static void Write(const std::string &path, Span<const Vertex> vertexes,
+                    const void *indexes, size_t indexCount,
+                    IndexTypeEnum indexType);
+};
+
+//! Mesh binary 파일을 memory mapping해서 읽는다.
+//! header만 검사하고 stream은 복사하거나 해석하지 않으므로, 실제 읽기는
+//! 처음 접근할 때 page fault로 일어난다. 반환된 Span은 객체가 살아있는
+//! 동안만 유효하다.
+class MappedMesh {
+public:
+  MappedMesh() = default;
+  //! 파일을 열지 못하거나 형식이 맞지 않으면 예외를 던진다.
+  explicit MappedMesh(const std::string &path);
+  ~MappedMesh();
+
+  MappedMesh(MappedMesh &&other) noexcept;
+  MappedMesh &operator=(MappedMesh &&other) noexcept;
+  MappedMesh(const MappedMesh &) = delete;
+  MappedMesh &operator=(const MappedMesh &) = delete;
+
+  bool IsOpen() const { return data != nullptr; }
+  const MeshFileHeader &Header() const;
+
+  Span<const Vertex> Vertexes() const;
+  IndexTypeEnum IndexType() const;
+  //! index 형식이 맞지 않으면 빈 Span을 반환한다.
+  Span<const uint32_t> Indexes32() const;
+  Span<const uint16_t> Indexes16() const;
+
+  //! mapping된 내용을 Mesh로 복사한다.
+  Mesh ToMesh() const;
+
+  void Close();
+
+private:
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+#if defined(_WIN32)
+  void *fileHandle = nullptr;
+  void *mappingHandle = nullptr;
+#endif
+};
+} // namespace Toybox
+
+#endif
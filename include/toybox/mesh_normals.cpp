@@ -0,0 +1,438 @@
+#include "toybox/mesh_normals.hpp"
+#include "toybox/mesh_soa.hpp"
+#include "toybox/profiler.hpp"
+#include "toybox/thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(TOYBOX_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+using namespace Toybox;
+
+namespace {
+//! SIMD로 한 번에 계산하는 삼각형 수 (8의 배수)
+constexpr size_t kBlock = 64;
+
+struct Vec3 {
+  float x;
+  float y;
+  float z;
+};
+
+Vec3 operator+(Vec3 a, Vec3 b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+Vec3 operator-(Vec3 a, Vec3 b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+Vec3 operator*(Vec3 a, float s) { return {a.x * s, a.y * s, a.z * s}; }
+float Dot(Vec3 a, Vec3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+Vec3 Cross(Vec3 a, Vec3 b) {
+  return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+          a.x * b.y - a.y * b.x};
+}
+Vec3 Position(const Vertex &v) { return {v.x, v.y, v.z}; }
+
+//! n에 수직인 평면으로 투영한 뒤 정규화한다. 길이가 0이면 false
+bool ProjectNormalize(Vec3 n, Vec3 &v) {
+  v = v - n * Dot(n, v);
+  float length = std::sqrt(Dot(v, v));
+  if (!(length > 0.0f))
+    return false;
+  v = v * (1.0f / length);
+  return true;
+}
+
+//> 삼각형별 계산
+//! 삼각형 kBlock개의 꼭짓점 속성 (SoA). 남는 칸은 0으로 채운다.
+struct TriangleBlock {
+  alignas(32) float p[3][3][kBlock]; // [corner][axis][triangle]
+  alignas(32) float t[3][2][kBlock]; // [corner][u/v][triangle]
+};
+
+void LoadBlock(const Mesh &mesh, size_t firstTriangle, size_t triangleCount,
+               bool texcoords, TriangleBlock &block) {
+  size_t count = std::min(kBlock, triangleCount - firstTriangle);
+  for (size_t corner = 0; corner < 3; ++corner) {
+    for (size_t i = 0; i < count; ++i) {
+      const Vertex &v =
+          mesh.vertexes[mesh.indexes[(firstTriangle + i) * 3 + corner]];
+      block.p[corner][0][i] = v.x;
+      block.p[corner][1][i] = v.y;
+      block.p[corner][2][i] = v.z;
+      if (texcoords) {
+        block.t[corner][0][i] = v.tx;
+        block.t[corner][1][i] = v.ty;
+      }
+    }
+    for (size_t i = count; i < kBlock; ++i) {
+      for (size_t axis = 0; axis < 3; ++axis)
+        block.p[corner][axis][i] = 0.0f;
+      block.t[corner][0][i] = block.t[corner][1][i] = 0.0f;
+    }
+  }
+}
+
+//! 삼각형별 결과 (SoA). 길이는 kBlock의 배수로 맞춘다.
+//! - normal: cross(p1 - p0, p2 - p0) (길이 = 면적 * 2)
+//! - tangent: UV의 u, v 증가 방향 (tx, ty, tz, bx, by, bz).
+//!   UV 면적이 0인 삼각형은 0이다.
+struct FaceArrays {
+  AlignedVector<float> values[6];
+
+  void Resize(size_t triangleCount, size_t arrayCount) {
+    size_t padded = (triangleCount + kBlock - 1) / kBlock * kBlock;
+    for (size_t k = 0; k < arrayCount; ++k)
+      values[k].resize(padded);
+  }
+};
+
+using FaceKernel = void (*)(const TriangleBlock &block, float *const *out);
+
+void FaceNormalsScalar(const TriangleBlock &b, float *const *out) {
+  for (size_t i = 0; i < kBlock; ++i) {
+    float e1x = b.p[1][0][i] - b.p[0][0][i];
+    float e1y = b.p[1][1][i] - b.p[0][1][i];
+    float e1z = b.p[1][2][i] - b.p[0][2][i];
+    float e2x = b.p[2][0][i] - b.p[0][0][i];
+    float e2y = b.p[2][1][i] - b.p[0][1][i];
+    float e2z = b.p[2][2][i] - b.p[0][2][i];
+    out[0][i] = e1y * e2z - e1z * e2y;
+    out[1][i] = e1z * e2x - e1x * e2z;
+    out[2][i] = e1x * e2y - e1y * e2x;
+  }
+}
+
+void FaceTangentsScalar(const TriangleBlock &b, float *const *out) {
+  for (size_t i = 0; i < kBlock; ++i) {
+    float e1[3], e2[3];
+    for (size_t axis = 0; axis < 3; ++axis) {
+      e1[axis] = b.p[1][axis][i] - b.p[0][axis][i];
+      e2[axis] = b.p[2][axis][i] - b.p[0][axis][i];
+    }
+    float du1 = b.t[1][0][i] - b.t[0][0][i];
+    float dv1 = b.t[1][1][i] - b.t[0][1][i];
+    float du2 = b.t[2][0][i] - b.t[0][0][i];
+    float dv2 = b.t[2][1][i] - b.t[0][1][i];
+    //=> UV 면적의 부호로 방향을 맞춘다. (크기는 나중에 정규화한다)
+    float area = du1 * dv2 - du2 * dv1;
+    float sign = area < 0.0f ? -1.0f : (area != 0.0f ? 1.0f : 0.0f);
+    for (size_t axis = 0; axis < 3; ++axis) {
+      out[axis][i] = (e1[axis] * dv2 - e2[axis] * dv1) * sign;
+      out[axis + 3][i] = (e2[axis] * du1 - e1[axis] * du2) * sign;
+    }
+  }
+}
+
+#if defined(TOYBOX_SIMD_X86)
+TOYBOX_TARGET_SSE void FaceNormalsSSE(const TriangleBlock &b,
+                                      float *const *out) {
+  for (size_t i = 0; i < kBlock; i += 4) {
+    __m128 p0x = _mm_load_ps(b.p[0][0] + i);
+    __m128 p0y = _mm_load_ps(b.p[0][1] + i);
+    __m128 p0z = _mm_load_ps(b.p[0][2] + i);
+    __m128 e1x = _mm_sub_ps(_mm_load_ps(b.p[1][0] + i), p0x);
+    __m128 e1y = _mm_sub_ps(_mm_load_ps(b.p[1][1] + i), p0y);
+    __m128 e1z = _mm_sub_ps(_mm_load_ps(b.p[1][2] + i), p0z);
+    __m128 e2x = _mm_sub_ps(_mm_load_ps(b.p[2][0] + i), p0x);
+    __m128 e2y = _mm_sub_ps(_mm_load_ps(b.p[2][1] + i), p0y);
+    __m128 e2z = _mm_sub_ps(_mm_load_ps(b.p[2][2] + i), p0z);
+    _mm_store_ps(out[0] + i,
+                 _mm_sub_ps(_mm_mul_ps(e1y, e2z), _mm_mul_ps(e1z, e2y)));
+    _mm_store_ps(out[1] + i,
+                 _mm_sub_ps(_mm_mul_ps(e1z, e2x), _mm_mul_ps(e1x, e2z)));
+    _mm_store_ps(out[2] + i,
+                 _mm_sub_ps(_mm_mul_ps(e1x, e2y), _mm_mul_ps(e1y, e2x)));
+  }
+}
+
+TOYBOX_TARGET_SSE void FaceTangentsSSE(const TriangleBlock &b,
+                                       float *const *out) {
+  const __m128 signBit = _mm_set1_ps(-0.0f);
+  for (size_t i = 0; i < kBlock; i += 4) {
+    __m128 t0u = _mm_load_ps(b.t[0][0] + i);
+    __m128 t0v = _mm_load_ps(b.t[0][1] + i);
+    __m128 du1 = _mm_sub_ps(_mm_load_ps(b.t[1][0] + i), t0u);
+    __m128 dv1 = _mm_sub_ps(_mm_load_ps(b.t[1][1] + i), t0v);
+    __m128 du2 = _mm_sub_ps(_mm_load_ps(b.t[2][0] + i), t0u);
+    __m128 dv2 = _mm_sub_ps(_mm_load_ps(b.t[2][1] + i), t0v);
+    __m128 area = _mm_sub_ps(_mm_mul_ps(du1, dv2), _mm_mul_ps(du2, dv1));
+    //=> 부호는 sign bit를 뒤집어 곱하고, 면적이 0이면 0으로 만든다.
+    __m128 sign = _mm_and_ps(area, signBit);
+    __m128 valid = _mm_cmpneq_ps(area, _mm_setzero_ps());
+    for (size_t axis = 0; axis < 3; ++axis) {
+      __m128 p0 = _mm_load_ps(b.p[0][axis] + i);
+      __m128 e1 = _mm_sub_ps(_mm_load_ps(b.p[1][axis] + i), p0);
+      __m128 e2 = _mm_sub_ps(_mm_load_ps(b.p[2][axis] + i), p0);
+      __m128 tangent = _mm_sub_ps(_mm_mul_ps(e1, dv2), _mm_mul_ps(e2, dv1));
+      __m128 bitangent = _mm_sub_ps(_mm_mul_ps(e2, du1), _mm_mul_ps(e1, du2));
+      _mm_store_ps(out[axis] + i,
+                   _mm_and_ps(_mm_xor_ps(tangent, sign), valid));
+      _mm_store_ps(out[axis + 3] + i,
+                   _mm_and_ps(_mm_xor_ps(bitangent, sign), valid));
+    }
+  }
+}
+
+TOYBOX_TARGET_AVX2 void FaceNormalsAVX2(const TriangleBlock &b,
+                                        float *const *out) {
+  for (size_t i = 0; i < kBlock; i += 8) {
+    __m256 p0x = _mm256_load_ps(b.p[0][0] + i);
+    __m256 p0y = _mm256_load_ps(b.p[0][1] + i);
+    __m256 p0z = _mm256_load_ps(b.p[0][2] + i);
+    __m256 e1x = _mm256_sub_ps(_mm256_load_ps(b.p[1][0] + i), p0x);
+    __m256 e1y = _mm256_sub_ps(_mm256_load_ps(b.p[1][1] + i), p0y);
+    __m256 e1z = _mm256_sub_ps(_mm256_load_ps(b.p[1][2] + i), p0z);
+    __m256 e2x = _mm256_sub_ps(_mm256_load_ps(b.p[2][0] + i), p0x);
+    __m256 e2y = _mm256_sub_ps(_mm256_load_ps(b.p[2][1] + i), p0y);
+    __m256 e2z = _mm256_sub_ps(_mm256_load_ps(b.p[2][2] + i), p0z);
+    _mm256_store_ps(out[0] + i, _mm256_sub_ps(_mm256_mul_ps(e1y, e2z),
+                                              _mm256_mul_ps(e1z, e2y)));
+    _mm256_store_ps(out[1] + i, _mm256_sub_ps(_mm256_mul_ps(e1z, e2x),
+                                              _mm256_mul_ps(e1x, e2z)));
+    _mm256_store_ps(out[2] + i, _mm256_sub_ps(_mm256_mul_ps(e1x, e2y),
+                                              _mm256_mul_ps(e1y, e2x)));
+  }
+}
+
+TOYBOX_TARGET_AVX2 void FaceTangentsAVX2(const TriangleBlock &b,
+                                         float *const *out) {
+  const __m256 signBit = _mm256_set1_ps(-0.0f);
+  for (size_t i = 0; i < kBlock; i += 8) {
+    __m256 t0u = _mm256_load_ps(b.t[0][0] + i);
+    __m256 t0v = _mm256_load_ps(b.t[0][1] + i);
+    __m256 du1 = _mm256_sub_ps(_mm256_load_ps(b.t[1][0] + i), t0u);
+    __m256 dv1 = _mm256_sub_ps(_mm256_load_ps(b.t[1][1] + i), t0v);
+    __m256 du2 = _mm256_sub_ps(_mm256_load_ps(b.t[2][0] + i), t0u);
+    __m256 dv2 = _mm256_sub_ps(_mm256_load_ps(b.t[2][1] + i), t0v);
+    __m256 area =
+        _mm256_sub_ps(_mm256_mul_ps(du1, dv2), _mm256_mul_ps(du2, dv1));
+    __m256 sign = _mm256_and_ps(area, signBit);
+    __m256 valid = _mm256_cmp_ps(area, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+    for (size_t axis = 0; axis < 3; ++axis) {
+      __m256 p0 = _mm256_load_ps(b.p[0][axis] + i);
+      __m256 e1 = _mm256_sub_ps(_mm256_load_ps(b.p[1][axis] + i), p0);
+      __m256 e2 = _mm256_sub_ps(_mm256_load_ps(b.p[2][axis] + i), p0);
+      __m256 tangent =
+          _mm256_sub_ps(_mm256_mul_ps(e1, dv2), _mm256_mul_ps(e2, dv1));
+      __m256 bitangent =
+          _mm256_sub_ps(_mm256_mul_ps(e2, du1), _mm256_mul_ps(e1, du2));
+      _mm256_store_ps(out[axis] + i,
+                      _mm256_and_ps(_mm256_xor_ps(tangent, sign), valid));
+      _mm256_store_ps(out[axis + 3] + i,
+                      _mm256_and_ps(_mm256_xor_ps(bitangent, sign), valid));
+    }
+  }
+}
+#endif
+
+FaceKernel SelectKernel(SimdLevelEnum level, bool tangents) {
+  switch (level) {
+#if defined(TOYBOX_SIMD_X86)
+  case SIMD_AVX2:
+    return tangents ? FaceTangentsAVX2 : FaceNormalsAVX2;
+  case SIMD_SSE:
+    return tangents ? FaceTangentsSSE : FaceNormalsSSE;
+#endif
+  default:
+    return tangents ? FaceTangentsScalar : FaceNormalsScalar;
+  }
+}
+
+//! 모든 삼각형의 값을 계산한다. block마다 결과 위치가 다르므로 나눠 실행한다.
+void ComputeFaces(SimdLevelEnum level, const Mesh &mesh, bool tangents,
+                  ThreadPool *pool, FaceArrays &faces) {
+  size_t triangleCount = mesh.indexes.size() / 3;
+  size_t arrayCount = tangents ? 6 : 3;
+  faces.Resize(triangleCount, arrayCount);
+  FaceKernel kernel = SelectKernel(level, tangents);
+  size_t blockCount = (triangleCount + kBlock - 1) / kBlock;
+  ParallelFor(pool, blockCount, kParallelGrain / kBlock, [&](size_t begin,
+                                                             size_t end) {
+    TriangleBlock block;
+    float *out[6];
+    for (size_t b = begin; b < end; ++b) {
+      LoadBlock(mesh, b * kBlock, triangleCount, tangents, block);
+      for (size_t k = 0; k < arrayCount; ++k)
+        out[k] = faces.values[k].data() + b * kBlock;
+      kernel(block, out);
+    }
+  });
+}
+
+//> vertex별 합산
+//! 값을 정할 수 없을 때 쓰는 n에 수직인 단위 벡터
+Vec3 AnyPerpendicular(Vec3 n) {
+  Vec3 axis = std::fabs(n.x) < 0.9f ? Vec3{1.0f, 0.0f, 0.0f}
+                                    : Vec3{0.0f, 1.0f, 0.0f};
+  return ProjectNormalize(n, axis) ? axis : Vec3{1.0f, 0.0f, 0.0f};
+}
+
+//! corner 꼭짓점에서 두 변이 이루는 각도. 변은 n에 수직인 평면으로 투영한다.
+float CornerAngle(const Mesh &mesh, uint32_t corner, Vec3 n) {
+  uint32_t first = corner - corner % 3;
+  Vec3 p = Position(mesh.vertexes[mesh.indexes[corner]]);
+  Vec3 a = Position(mesh.vertexes[mesh.indexes[first + (corner + 1) % 3]]) - p;
+  Vec3 b = Position(mesh.vertexes[mesh.indexes[first + (corner + 2) % 3]]) - p;
+  if (!ProjectNormalize(n, a) || !ProjectNormalize(n, b))
+    return 0.0f;
+  return std::acos(std::max(-1.0f, std::min(1.0f, Dot(a, b))));
+}
+
+void AccumulateNormals(Mesh &mesh, const VertexAdjacency &adjacency,
+                       const FaceArrays &faces, ThreadPool *pool) {
+  const float *fx = faces.values[0].data();
+  const float *fy = faces.values[1].data();
+  const float *fz = faces.values[2].data();
+  ParallelFor(pool, mesh.vertexes.size(), kParallelGrain, [&](size_t begin,
+                                                              size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      Vec3 sum = {0.0f, 0.0f, 0.0f};
+      for (uint32_t i = adjacency.offsets[v]; i < adjacency.offsets[v + 1];
+           ++i) {
+        uint32_t triangle = adjacency.corners[i] / 3;
+        sum = sum + Vec3{fx[triangle], fy[triangle], fz[triangle]};
+      }
+      float length = std::sqrt(Dot(sum, sum));
+      if (!(length > 0.0f))
+        continue;
+      Vertex &vertex = mesh.vertexes[v];
+      vertex.nx = sum.x / length;
+      vertex.ny = sum.y / length;
+      vertex.nz = sum.z / length;
+    }
+  });
+}
+
+void AccumulateTangents(const Mesh &mesh, const VertexAdjacency &adjacency,
+                        const FaceArrays &faces, ThreadPool *pool,
+                        std::vector<Tangent> &tangents) {
+  ParallelFor(pool, mesh.vertexes.size(), kParallelGrain, [&](size_t begin,
+                                                              size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      const Vertex &vertex = mesh.vertexes[v];
+      Vec3 n = {vertex.nx, vertex.ny, vertex.nz};
+      float normalLength = std::sqrt(Dot(n, n));
+      n = normalLength > 0.0f ? n * (1.0f / normalLength) : n;
+
+      Vec3 tangentSum = {0.0f, 0.0f, 0.0f};
+      Vec3 bitangentSum = {0.0f, 0.0f, 0.0f};
+      for (uint32_t i = adjacency.offsets[v]; i < adjacency.offsets[v + 1];
+           ++i) {
+        uint32_t corner = adjacency.corners[i];
+        uint32_t triangle = corner / 3;
+        Vec3 tangent = {faces.values[0][triangle], faces.values[1][triangle],
+                        faces.values[2][triangle]};
+        Vec3 bitangent = {faces.values[3][triangle],
+                          faces.values[4][triangle],
+                          faces.values[5][triangle]};
+        if (!ProjectNormalize(n, tangent))
+          continue;
+        float angle = CornerAngle(mesh, corner, n);
+        tangentSum = tangentSum + tangent * angle;
+        if (ProjectNormalize(n, bitangent))
+          bitangentSum = bitangentSum + bitangent * angle;
+      }
+
+      Vec3 t = tangentSum;
+      if (!ProjectNormalize(n, t))
+        t = AnyPerpendicular(n);
+      float w = Dot(Cross(n, t), bitangentSum) < 0.0f ? -1.0f : 1.0f;
+      tangents[v] = {t.x, t.y, t.z, w};
+    }
+  });
+}
+
+//! adjacency가 없으면 built에 만들어 반환한다.
+const VertexAdjacency &ResolveAdjacency(const Mesh &mesh,
+                                        const VertexAdjacency *adjacency,
+                                        VertexAdjacency &built) {
+  if (adjacency == nullptr) {
+    built = MeshNormals::BuildAdjacency(mesh);
+    return built;
+  }
+  if (adjacency->VertexCount() != mesh.vertexes.size() ||
+      adjacency->corners.size() != mesh.indexes.size())
+    throw std::runtime_error("adjacency가 Mesh와 맞지 않습니다.");
+  return *adjacency;
+}
+} // namespace
+
+//> MeshNormals
+VertexAdjacency MeshNormals::BuildAdjacency(const Mesh &mesh) {
+  if (mesh.indexes.size() % 3 != 0)
+    throw std::runtime_error("index 수가 3의 배수가 아닙니다.");
+  if (mesh.indexes.size() >= size_t(UINT32_MAX) ||
+      mesh.vertexes.size() >= size_t(UINT32_MAX))
+    throw std::runtime_error("vertex 또는 index 수가 너무 많습니다.");
+
+  size_t vertexCount = mesh.vertexes.size();
+  VertexAdjacency adjacency;
+  adjacency.offsets.assign(vertexCount + 1, 0);
+  for (uint32_t index : mesh.indexes) {
+    if (index >= vertexCount)
+      throw std::runtime_error("index가 vertex 범위를 벗어났습니다.");
+    ++adjacency.offsets[index + 1];
+  }
+  for (size_t v = 0; v < vertexCount; ++v)
+    adjacency.offsets[v + 1] += adjacency.offsets[v];
+
+  //=> corner 번호 순서로 채우므로 vertex마다 삼각형 순서가 유지된다.
+  std::vector<uint32_t> cursor(adjacency.offsets.begin(),
+                               adjacency.offsets.end() - 1);
+  adjacency.corners.resize(mesh.indexes.size());
+  for (size_t corner = 0; corner < mesh.indexes.size(); ++corner)
+    adjacency.corners[cursor[mesh.indexes[corner]]++] = uint32_t(corner);
+  return adjacency;
+}
+
+void MeshNormals::ComputeNormals(Mesh &mesh,
+                                 const VertexAdjacency *adjacency) {
+  ComputeNormals(DetectSimdLevel(), mesh, nullptr, adjacency);
+}
+
+void MeshNormals::ComputeNormals(Mesh &mesh, ThreadPool &pool,
+                                 const VertexAdjacency *adjacency) {
+  ComputeNormals(DetectSimdLevel(), mesh, &pool, adjacency);
+}
+
+void MeshNormals::ComputeTangents(const Mesh &mesh,
+                                  std::vector<Tangent> &tangents,
+                                  const VertexAdjacency *adjacency) {
+  ComputeTangents(DetectSimdLevel(), mesh, tangents, nullptr, adjacency);
+}
+
+void MeshNormals::ComputeTangents(const Mesh &mesh,
+                                  std::vector<Tangent> &tangents,
+                                  ThreadPool &pool,
+                                  const VertexAdjacency *adjacency) {
+  ComputeTangents(DetectSimdLevel(), mesh, tangents, &pool, adjacency);
+}
+
+void MeshNormals::ComputeNormals(SimdLevelEnum level, Mesh &mesh,
+                                 ThreadPool *pool,
+                                 const VertexAdjacency *adjacency) {
+  TOYBOX_PROFILE_SCOPE(profile, "MeshNormals::ComputeNormals");
+  VertexAdjacency built;
+  const VertexAdjacency &resolved = ResolveAdjacency(mesh, adjacency, built);
+
+  FaceArrays faces;
+  ComputeFaces(level, mesh, false, pool, faces);
+  AccumulateNormals(mesh, resolved, faces, pool);
+  TOYBOX_PROFILE_OUTPUT(profile, mesh.vertexes.size(), mesh.indexes.size(), 0);
+}
+
+void MeshNormals::ComputeTangents(SimdLevelEnum level, const Mesh &mesh,
+                                  std::vector<Tangent> &tangents,
+                                  ThreadPool *pool,
+                                  const VertexAdjacency *adjacency) {
+  TOYBOX_PROFILE_SCOPE(profile, "MeshNormals::ComputeTangents");
+  VertexAdjacency built;
+  const VertexAdjacency &resolved = ResolveAdjacency(mesh, adjacency, built);
+
+  FaceArrays faces;
+  ComputeFaces(level, mesh, true, pool, faces);
+  tangents.resize(mesh.vertexes.size());
+  AccumulateTangents(mesh, resolved, faces, pool, tangents);
+  TOYBOX_PROFILE_OUTPUT(profile, tangents.size(), mesh.indexes.size(),
+                        tangents.size() * sizeof(Tangent));
+}
@@ -0,0 +1,71 @@
+#ifndef TOYBOX_MESH_NORMALS_H
+#define TOYBOX_MESH_NORMALS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <toybox/simd.hpp>
+#include <toybox/vertex.hpp>
+#include <vector>
+
+namespace Toybox {
+
+class ThreadPool;
+
+//! vertex 하나의 tangent. w는 bitangent 방향 부호(+1 / -1)이다.
+//! bitangent = w * cross(normal, tangent) (MikkTSpace와 같은 규칙)
+struct Tangent {
+  float x;
+  float y;
+  float z;
+  float w;
+};
+
+//! vertex마다 그 vertex를 사용하는 corner(삼각형 번호 * 3 + 꼭짓점 순서) 목록.
+//! vertex v의 corner는 corners[offsets[v]] ~ corners[offsets[v + 1] - 1]이며
+//! 삼각형 순서대로 놓인다. indexes가 바뀌지 않으면 매번 다시 만들 필요가 없다.
+struct VertexAdjacency {
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> corners;
+
+  size_t VertexCount() const {
+    return offsets.empty() ? 0 : offsets.size() - 1;
+  }
+};
+
+//! 삼각형으로부터 vertex normal과 tangent를 다시 계산한다.
+//! 1. 삼각형별 값을 SIMD로 계산한다. (CPU가 지원하면 AVX2 / SSE)
+//! 2. vertex별로 인접한 삼각형의 값을 모은다. vertex마다 한 thread만 쓰므로
+//!    atomic이 필요 없으며, 결과는 thread 수와 SIMD 수준에 관계없이 같다.
+//! adjacency를 주면 그것을 사용하고, nullptr이면 호출마다 만든다.
+class MeshNormals {
+public:
+  //! indexes 길이가 3의 배수가 아니거나 범위를 벗어나면 예외를 던진다.
+  static VertexAdjacency BuildAdjacency(const Mesh &mesh);
+
+  //! 면적 가중 face normal의 합을 정규화해 nx, ny, nz에 쓴다.
+  //! 인접한 삼각형이 없거나 합이 0인 vertex는 기존 normal을 유지한다.
+  static void ComputeNormals(Mesh &mesh,
+                             const VertexAdjacency *adjacency = nullptr);
+  static void ComputeNormals(Mesh &mesh, ThreadPool &pool,
+                             const VertexAdjacency *adjacency = nullptr);
+
+  //! MikkTSpace 방식의 tangent를 계산해 tangents에 vertex 수만큼 쓴다.
+  //! 삼각형의 UV 방향을 vertex normal에 수직인 평면으로 투영하고, 꼭짓점
+  //! 각도로 가중해 더한다. vertex normal을 사용하므로 normal을 먼저 계산해야
+  //! 한다. 값을 정할 수 없는 vertex는 normal에 수직인 임의의 방향을 갖는다.
+  static void ComputeTangents(const Mesh &mesh, std::vector<Tangent> &tangents,
+                              const VertexAdjacency *adjacency = nullptr);
+  static void ComputeTangents(const Mesh &mesh, std::vector<Tangent> &tangents,
+                              ThreadPool &pool,
+                              const VertexAdjacency *adjacency = nullptr);
+
+  //! SIMD 수준을 직접 지정한다. (결과 비교 및 성능 측정용)
+  static void ComputeNormals(SimdLevelEnum level, Mesh &mesh, ThreadPool *pool,
+                             const VertexAdjacency *adjacency);
+  static void ComputeTangents(SimdLevelEnum level, const Mesh &mesh,
+                              std::vector<Tangent> &tangents, ThreadPool *pool,
+                              const VertexAdjacency *adjacency);
+};
+} // namespace Toybox
+
+#endif
@@ -0,0 +1,234 @@
+#include "toybox/mesh_optimizer.hpp"
+#include "toybox/profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace Toybox;
+
+namespace {
+//> Forsyth 점수 계산에 사용하는 LRU cache 모델
+constexpr int kScoreCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+constexpr uint32_t kMaxValenceTable = 32;
+constexpr uint32_t kInvalid = std::numeric_limits<uint32_t>::max();
+
+//! pow 계산을 피하기 위해 cache 위치별, 남은 삼각형 수별 점수를 미리 계산한다.
+struct ScoreTable {
+  float cache[kScoreCacheSize];
+  float valence[kMaxValenceTable];
+
+  ScoreTable() {
+    for (int i = 0; i < kScoreCacheSize; ++i) {
+      if (i < 3) {
+        cache[i] = kLastTriangleScore;
+      } else {
+        float scaler = 1.0f / (kScoreCacheSize - 3);
+        cache[i] = std::pow(1.0f - (i - 3) * scaler, kCacheDecayPower);
+      }
+    }
+    valence[0] = 0.0f;
+    for (uint32_t i = 1; i < kMaxValenceTable; ++i)
+      valence[i] = kValenceBoostScale * std::pow(float(i), -kValenceBoostPower);
+  }
+};
+
+//! cache 위치와 남은 삼각형 수로 vertex 점수를 계산한다.
+//! - 직전 삼각형의 vertex는 고정 점수를 받는다. (같은 삼각형 반복 방지)
+//! - 남은 삼각형이 적을수록 점수를 높여 고립된 삼각형이 생기지 않게 한다.
+float VertexScore(const ScoreTable &table, int cachePosition,
+                  uint32_t remainingValence) {
+  if (remainingValence == 0)
+    return -1.0f;
+
+  float score = cachePosition >= 0 ? table.cache[cachePosition] : 0.0f;
+  if (remainingValence < kMaxValenceTable)
+    score += table.valence[remainingValence];
+  else
+    score += kValenceBoostScale *
+             std::pow(float(remainingValence), -kValenceBoostPower);
+  return score;
+}
+
+//! 범위를 벗어난 index가 있으면 배열을 건드리기 전에 예외를 던진다.
+void CheckIndexes(Span<const uint32_t> indexes, size_t vertexCount) {
+  for (uint32_t index : indexes) {
+    if (index >= vertexCount)
+      throw std::runtime_error("index가 vertex 범위를 벗어났습니다.");
+  }
+}
+} // namespace
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(Span<const uint32_t> indexes,
+                                                   size_t vertexCount,
+                                                   size_t cacheSize) {
+  CheckIndexes(indexes, vertexCount);
+  VertexCacheStats stats;
+  stats.triangleCount = indexes.size() / 3;
+  stats.vertexCount = vertexCount;
+
+  //=> miss가 날 때마다 시간을 1 증가시키면, 마지막으로 들어온 시각과의
+  //=> 차이가 cacheSize 미만인 vertex가 FIFO cache 안에 있는 vertex이다.
+  std::vector<size_t> timestamp(vertexCount, 0);
+  size_t time = cacheSize + 1;
+  for (size_t i = 0; i < stats.triangleCount * 3; ++i) {
+    uint32_t v = indexes[i];
+    if (time - timestamp[v] > cacheSize) {
+      timestamp[v] = time++;
+      ++stats.transformCount;
+    }
+  }
+  return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(Span<uint32_t> indexes,
+                                        size_t vertexCount) {
+  size_t triangleCount = indexes.size() / 3;
+  if (triangleCount == 0)
+    return;
+  CheckIndexes(Span<const uint32_t>(indexes.data(), indexes.size()),
+               vertexCount);
+
+  //> vertex별 인접 삼각형 목록 (CSR 형태)
+  std::vector<uint32_t> remaining(vertexCount, 0);
+  for (size_t i = 0; i < triangleCount * 3; ++i)
+    ++remaining[indexes[i]];
+
+  std::vector<uint32_t> offsets(vertexCount + 1, 0);
+  for (size_t v = 0; v < vertexCount; ++v)
+    offsets[v + 1] = offsets[v] + remaining[v];
+
+  std::vector<uint32_t> adjacency(triangleCount * 3);
+  {
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+      adjacency[cursor[indexes[i]]++] = uint32_t(i / 3);
+  }
+
+  //> 초기 점수
+  static const ScoreTable table;
+  std::vector<int> cachePosition(vertexCount, -1);
+  std::vector<float> vertexScore(vertexCount);
+  for (size_t v = 0; v < vertexCount; ++v)
+    vertexScore[v] = VertexScore(table, -1, remaining[v]);
+
+  std::vector<float> triangleScore(triangleCount);
+  std::vector<char> emitted(triangleCount, 0);
+  uint32_t bestTriangle = 0;
+  for (size_t t = 0; t < triangleCount; ++t) {
+    triangleScore[t] = vertexScore[indexes[t * 3]] +
+                       vertexScore[indexes[t * 3 + 1]] +
+                       vertexScore[indexes[t * 3 + 2]];
+    if (triangleScore[t] > triangleScore[bestTriangle])
+      bestTriangle = uint32_t(t);
+  }
+
+  std::vector<uint32_t> output(triangleCount * 3);
+  uint32_t cache[kScoreCacheSize + 3];
+  uint32_t nextCache[kScoreCacheSize + 3];
+  int cacheCount = 0;
+  size_t scanPosition = 0;
+
+  for (size_t out = 0; out < triangleCount; ++out) {
+    //=> cache에서 후보를 찾지 못하면 아직 내보내지 않은 첫 삼각형을 사용한다.
+    if (bestTriangle == kInvalid) {
+      while (emitted[scanPosition])
+        ++scanPosition;
+      bestTriangle = uint32_t(scanPosition);
+    }
+
+    const uint32_t *triangle = &indexes[size_t(bestTriangle) * 3];
+    std::copy(triangle, triangle + 3, &output[out * 3]);
+    emitted[bestTriangle] = 1;
+
+    //> 내보낸 삼각형을 인접 목록에서 제거한다.
+    for (int k = 0; k < 3; ++k) {
+      uint32_t v = triangle[k];
+      uint32_t *begin = &adjacency[offsets[v]];
+      uint32_t *end = begin + remaining[v];
+      uint32_t *found = std::find(begin, end, bestTriangle);
+      if (found != end) {
+        std::swap(*found, *(end - 1));
+        --remaining[v];
+      }
+    }
+
+    //> 방금 사용한 vertex를 LRU cache 앞쪽으로 옮긴다.
+    int nextCount = 0;
+    for (int k = 0; k < 3; ++k) {
+      uint32_t v = triangle[k];
+      if (std::find(nextCache, nextCache + nextCount, v) ==
+          nextCache + nextCount)
+        nextCache[nextCount++] = v;
+    }
+    for (int i = 0; i < cacheCount; ++i) {
+      uint32_t v = cache[i];
+      if (std::find(nextCache, nextCache + nextCount, v) ==
+          nextCache + nextCount)
+        nextCache[nextCount++] = v;
+    }
+
+    //> cache 위치가 바뀐 vertex와 그 인접 삼각형의 점수를 갱신하고,
+    //> 그 중 가장 점수가 높은 삼각형을 다음 후보로 고른다.
+    bestTriangle = kInvalid;
+    float bestScore = -1.0f;
+    for (int i = 0; i < nextCount; ++i) {
+      uint32_t v = nextCache[i];
+      cachePosition[v] = i < kScoreCacheSize ? i : -1;
+      float score = VertexScore(table, cachePosition[v], remaining[v]);
+      float delta = score - vertexScore[v];
+      vertexScore[v] = score;
+
+      for (uint32_t a = 0; a < remaining[v]; ++a) {
+        uint32_t t = adjacency[offsets[v] + a];
+        triangleScore[t] += delta;
+        if (cachePosition[v] >= 0 && triangleScore[t] > bestScore) {
+          bestScore = triangleScore[t];
+          bestTriangle = t;
+        }
+      }
+    }
+    cacheCount = std::min(nextCount, kScoreCacheSize);
+    std::copy(nextCache, nextCache + cacheCount, cache);
+  }
+
+  std::copy(output.begin(), output.end(), indexes.begin());
+}
+
+void MeshOptimizer::OptimizeVertexFetch(Mesh &mesh) {
+  size_t vertexCount = mesh.vertexes.size();
+  CheckIndexes(mesh.indexes, vertexCount);
+  std::vector<uint32_t> remap(vertexCount, kInvalid);
+  uint32_t next = 0;
+  for (auto &index : mesh.indexes) {
+    if (remap[index] == kInvalid)
+      remap[index] = next++;
+    index = remap[index];
+  }
+  for (auto &target : remap)
+    if (target == kInvalid)
+      target = next++;
+
+  std::vector<Vertex> vertexes(vertexCount);
+  for (size_t v = 0; v < vertexCount; ++v)
+    vertexes[remap[v]] = mesh.vertexes[v];
+  mesh.vertexes.swap(vertexes);
+}
+
+MeshOptimizeReport MeshOptimizer::Optimize(Mesh &mesh, size_t cacheSize) {
+  TOYBOX_PROFILE_SCOPE(profile, "MeshOptimizer::Optimize");
+  TOYBOX_PROFILE_OUTPUT(profile, mesh.vertexes.size(), mesh.indexes.size(), 0);
+  MeshOptimizeReport report;
+  report.before =
+      AnalyzeVertexCache(mesh.indexes, mesh.vertexes.size(), cacheSize);
+  OptimizeVertexCache(mesh.indexes, mesh.vertexes.size());
+  OptimizeVertexFetch(mesh);
+  report.after =
+      AnalyzeVertexCache(mesh.indexes, mesh.vertexes.size(), cacheSize);
+  return report;
+}
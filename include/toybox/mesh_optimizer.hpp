@@ -0,0 +1,62 @@
+#ifndef TOYBOX_MESH_OPTIMIZER_H
+#define TOYBOX_MESH_OPTIMIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <toybox/span.hpp>
+#include <toybox/vertex.hpp>
+
+namespace Toybox {
+
+//! post-transform vertex cache 모의 실행 결과
+struct VertexCacheStats {
+  size_t triangleCount = 0;
+  size_t vertexCount = 0;
+  size_t transformCount = 0; // cache miss로 vertex shader가 실행된 횟수
+
+  //! 삼각형당 평균 cache miss 수 (0.5 ~ 3.0, 낮을수록 좋다)
+  float ACMR() const {
+    return triangleCount == 0 ? 0.0f : float(transformCount) / triangleCount;
+  }
+  //! vertex당 평균 변환 수 (1.0이 최적)
+  float ATVR() const {
+    return vertexCount == 0 ? 0.0f : float(transformCount) / vertexCount;
+  }
+};
+
+//! 최적화 전후 비교
+struct MeshOptimizeReport {
+  VertexCacheStats before;
+  VertexCacheStats after;
+};
+
+//! GPU vertex cache와 vertex fetch 효율을 위해 Mesh 순서를 바꾼다.
+//! 삼각형 집합과 vertex 속성은 바뀌지 않고 순서만 바뀐다.
+//! vertexCount 이상인 index가 있으면 아무것도 바꾸지 않고 runtime_error를
+//! 던진다.
+class MeshOptimizer {
+public:
+  //! 일반적인 GPU의 FIFO cache 크기
+  static constexpr size_t kDefaultCacheSize = 16;
+
+  //! FIFO cache를 모의 실행해 ACMR / ATVR을 계산한다.
+  static VertexCacheStats
+  AnalyzeVertexCache(Span<const uint32_t> indexes, size_t vertexCount,
+                     size_t cacheSize = kDefaultCacheSize);
+
+  //! Forsyth 방식(linear-speed vertex cache optimisation)으로 삼각형 순서를
+  //! 바꾼다. cache 안의 vertex를 많이 쓰는 삼각형을 먼저 내보낸다.
+  static void OptimizeVertexCache(Span<uint32_t> indexes, size_t vertexCount);
+
+  //! index에서 처음 사용되는 순서대로 vertex를 재배치하고 index를 고친다.
+  //! 사용되지 않는 vertex는 뒤로 보낸다.
+  static void OptimizeVertexFetch(Mesh &mesh);
+
+  //! OptimizeVertexCache 후 OptimizeVertexFetch를 실행하고 전후 통계를
+  //! 반환한다.
+  static MeshOptimizeReport Optimize(Mesh &mesh,
+                                     size_t cacheSize = kDefaultCacheSize);
+};
+} // namespace Toybox
+
+#endif
@@ -0,0 +1,368 @@
+#include "toybox/mesh_simplifier.hpp"
+#include "toybox/profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace Toybox;
+
+namespace {
+//! 평면까지 거리 제곱의 합을 나타내는 4x4 대칭 행렬 (상삼각 10개 원소)
+struct Quadric {
+  double aa = 0, ab = 0, ac = 0, ad = 0;
+  double bb = 0, bc = 0, bd = 0;
+  double cc = 0, cd = 0;
+  double dd = 0;
+
+  void AddPlane(double a, double b, double c, double d) {
+    aa += a * a, ab += a * b, ac += a * c, ad += a * d;
+    bb += b * b, bc += b * c, bd += b * d;
+    cc += c * c, cd += c * d;
+    dd += d * d;
+  }
+
+  Quadric &operator+=(const Quadric &q) {
+    aa += q.aa, ab += q.ab, ac += q.ac, ad += q.ad;
+    bb += q.bb, bc += q.bc, bd += q.bd;
+    cc += q.cc, cd += q.cd;
+    dd += q.dd;
+    return *this;
+  }
+
+  //! 점 (x, y, z)에서의 오차 (거리 제곱의 합)
+  double Evaluate(double x, double y, double z) const {
+    return aa * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x +
+           bb * y * y + 2 * bc * y * z + 2 * bd * y + cc * z * z +
+           2 * cd * z + dd;
+  }
+};
+
+struct Collapse {
+  double cost;
+  uint32_t from;
+  uint32_t to;
+  uint32_t fromVersion;
+  uint32_t toVersion;
+
+  //=> priority_queue가 비용이 작은 것부터 꺼내도록 반대로 비교한다.
+  bool operator<(const Collapse &other) const { return cost > other.cost; }
+};
+
+struct Vec3 {
+  double x, y, z;
+};
+
+Vec3 Position(const Vertex &v) { return Vec3{v.x, v.y, v.z}; }
+
+Vec3 Cross(const Vec3 &a, const Vec3 &b, const Vec3 &c) {
+  double ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+  double vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+  return Vec3{uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx};
+}
+
+double Dot(const Vec3 &a, const Vec3 &b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+//! 위치가 같은 vertex를 같은 번호로 묶는다.
+std::vector<uint32_t> WeldPositions(const std::vector<Vertex> &vertexes) {
+  struct PositionKey {
+    uint32_t bits[3];
+    bool operator==(const PositionKey &other) const {
+      return bits[0] == other.bits[0] && bits[1] == other.bits[1] &&
+             bits[2] == other.bits[2];
+    }
+  };
+  struct PositionHash {
+    size_t operator()(const PositionKey &key) const {
+      uint64_t h = key.bits[0] * 0x9E3779B1ull;
+      h = (h ^ key.bits[1]) * 0x85EBCA77ull;
+      h = (h ^ key.bits[2]) * 0xC2B2AE3Dull;
+      return size_t(h ^ (h >> 29));
+    }
+  };
+
+  std::unordered_map<PositionKey, uint32_t, PositionHash> lookup;
+  lookup.reserve(vertexes.size());
+  std::vector<uint32_t> positionIds(vertexes.size());
+  for (size_t i = 0; i < vertexes.size(); ++i) {
+    //=> -0.0과 0.0을 같은 위치로 본다.
+    const float position[3] = {vertexes[i].x + 0.0f, vertexes[i].y + 0.0f,
+                               vertexes[i].z + 0.0f};
+    PositionKey key;
+    std::memcpy(key.bits, position, sizeof(key.bits));
+    auto inserted = lookup.emplace(key, uint32_t(lookup.size()));
+    positionIds[i] = inserted.first->second;
+  }
+  return positionIds;
+}
+
+//! 범위를 벗어난 index가 있으면 예외를 던진다.
+void CheckIndexes(const Mesh &mesh) {
+  for (uint32_t index : mesh.indexes) {
+    if (index >= mesh.vertexes.size())
+      throw std::runtime_error("index가 vertex 범위를 벗어났습니다.");
+  }
+}
+
+class Simplifier {
+public:
+  explicit Simplifier(const Mesh &mesh)
+      : mesh(mesh), indexes(mesh.indexes),
+        positionIds(WeldPositions(mesh.vertexes)) {
+    size_t vertexCount = mesh.vertexes.size();
+    size_t triangleCount = indexes.size() / 3;
+    indexes.resize(triangleCount * 3);
+    quadrics.resize(vertexCount);
+    locked.assign(vertexCount, 0);
+    removed.assign(vertexCount, 0);
+    version.assign(vertexCount, 0);
+    vertexTriangles.resize(vertexCount);
+    triangleAlive.assign(triangleCount, 1);
+    aliveTriangles = triangleCount;
+
+    LockSeamsAndBorders();
+    for (size_t t = 0; t < triangleCount; ++t) {
+      const uint32_t *tri = &indexes[t * 3];
+      for (int k = 0; k < 3; ++k)
+        vertexTriangles[tri[k]].push_back(uint32_t(t));
+
+      //=> 면적이 0인 삼각형은 평면이 없으므로 quadric에 더하지 않는다.
+      Vec3 normal = Cross(Position(mesh.vertexes[tri[0]]),
+                          Position(mesh.vertexes[tri[1]]),
+                          Position(mesh.vertexes[tri[2]]));
+      double length = std::sqrt(Dot(normal, normal));
+      if (length <= 0.0)
+        continue;
+      double a = normal.x / length, b = normal.y / length,
+             c = normal.z / length;
+      double d = -Dot(Vec3{a, b, c}, Position(mesh.vertexes[tri[0]]));
+      Quadric plane;
+      plane.AddPlane(a, b, c, d);
+      for (int k = 0; k < 3; ++k)
+        quadrics[tri[k]] += plane;
+    }
+
+    for (size_t t = 0; t < triangleCount; ++t) {
+      const uint32_t *tri = &indexes[t * 3];
+      for (int k = 0; k < 3; ++k)
+        PushCandidate(tri[k], tri[(k + 1) % 3]);
+    }
+  }
+
+  float Run(const SimplifyParams &params) {
+    double maxCost = double(params.maxError) * params.maxError;
+    double maxAppliedCost = 0.0;
+    while (aliveTriangles > params.targetTriangleCount && !heap.empty()) {
+      Collapse collapse = heap.top();
+      heap.pop();
+      if (removed[collapse.from] || removed[collapse.to] ||
+          version[collapse.from] != collapse.fromVersion ||
+          version[collapse.to] != collapse.toVersion)
+        continue;
+      if (collapse.cost > maxCost)
+        break;
+      if (Flips(collapse.from, collapse.to))
+        continue;
+
+      Apply(collapse.from, collapse.to);
+      maxAppliedCost = std::max(maxAppliedCost, collapse.cost);
+    }
+    return float(std::sqrt(maxAppliedCost));
+  }
+
+  //! 남은 삼각형과 사용 중인 vertex만 원래 순서대로 모은다.
+  Mesh Output() const {
+    Mesh result;
+    std::vector<uint32_t> remap(mesh.vertexes.size(), UINT32_MAX);
+    for (size_t t = 0; t < triangleAlive.size(); ++t) {
+      if (!triangleAlive[t])
+        continue;
+      const uint32_t *tri = &indexes[t * 3];
+      //=> 위치가 겹쳐 면적이 없는 삼각형은 버린다.
+      if (positionIds[tri[0]] == positionIds[tri[1]] ||
+          positionIds[tri[1]] == positionIds[tri[2]] ||
+          positionIds[tri[2]] == positionIds[tri[0]])
+        continue;
+      for (int k = 0; k < 3; ++k) {
+        remap[tri[k]] = 0;
+        result.indexes.push_back(tri[k]);
+      }
+    }
+
+    uint32_t next = 0;
+    for (size_t v = 0; v < remap.size(); ++v) {
+      if (remap[v] == UINT32_MAX)
+        continue;
+      remap[v] = next++;
+      result.vertexes.push_back(mesh.vertexes[v]);
+    }
+    for (auto &index : result.indexes)
+      index = remap[index];
+    return result;
+  }
+
+private:
+  //! 위치가 같은 vertex가 여럿인 곳(seam)과, 삼각형 하나에만 속한 edge(열린
+  //! 경계) 또는 셋 이상에 속한 edge(non-manifold)의 vertex를 고정한다.
+  void LockSeamsAndBorders() {
+    std::vector<uint32_t> wedgeCount(mesh.vertexes.size(), 0);
+    for (uint32_t id : positionIds)
+      ++wedgeCount[id];
+    for (size_t v = 0; v < positionIds.size(); ++v)
+      if (wedgeCount[positionIds[v]] > 1)
+        locked[v] = 1;
+
+    std::unordered_map<uint64_t, uint32_t> edgeUse;
+    edgeUse.reserve(indexes.size());
+    auto edgeKey = [this](uint32_t a, uint32_t b) {
+      uint64_t pa = positionIds[a], pb = positionIds[b];
+      return pa < pb ? (pa << 32) | pb : (pb << 32) | pa;
+    };
+    for (size_t i = 0; i < indexes.size(); i += 3)
+      for (int k = 0; k < 3; ++k)
+        ++edgeUse[edgeKey(indexes[i + k], indexes[i + (k + 1) % 3])];
+
+    for (size_t i = 0; i < indexes.size(); i += 3) {
+      for (int k = 0; k < 3; ++k) {
+        uint32_t a = indexes[i + k];
+        uint32_t b = indexes[i + (k + 1) % 3];
+        if (edgeUse[edgeKey(a, b)] != 2)
+          locked[a] = locked[b] = 1;
+      }
+    }
+  }
+
+  //! 두 방향 중 가능한 쪽, 비용이 작은 쪽을 후보로 넣는다.
+  void PushCandidate(uint32_t a, uint32_t b) {
+    if (a == b || (locked[a] && locked[b]))
+      return;
+    Quadric merged = quadrics[a];
+    merged += quadrics[b];
+    const Vertex &va = mesh.vertexes[a];
+    const Vertex &vb = mesh.vertexes[b];
+    double costToB = locked[a] ? HUGE_VAL : merged.Evaluate(vb.x, vb.y, vb.z);
+    double costToA = locked[b] ? HUGE_VAL : merged.Evaluate(va.x, va.y, va.z);
+    if (costToB <= costToA)
+      heap.push(Collapse{std::max(costToB, 0.0), a, b, version[a], version[b]});
+    else
+      heap.push(Collapse{std::max(costToA, 0.0), b, a, version[b], version[a]});
+  }
+
+  //! from을 to 위치로 옮겼을 때 뒤집히는 삼각형이 있는지 검사한다.
+  bool Flips(uint32_t from, uint32_t to) const {
+    Vec3 target = Position(mesh.vertexes[to]);
+    for (uint32_t t : vertexTriangles[from]) {
+      if (!triangleAlive[t])
+        continue;
+      const uint32_t *tri = &indexes[size_t(t) * 3];
+      if (tri[0] == to || tri[1] == to || tri[2] == to)
+        continue;
+
+      Vec3 before[3], after[3];
+      for (int k = 0; k < 3; ++k) {
+        before[k] = Position(mesh.vertexes[tri[k]]);
+        after[k] = tri[k] == from ? target : before[k];
+      }
+      Vec3 oldNormal = Cross(before[0], before[1], before[2]);
+      Vec3 newNormal = Cross(after[0], after[1], after[2]);
+      if (Dot(oldNormal, oldNormal) > 0.0 && Dot(oldNormal, newNormal) <= 0.0)
+        return true;
+    }
+    return false;
+  }
+
+  void Apply(uint32_t from, uint32_t to) {
+    for (uint32_t t : vertexTriangles[from]) {
+      if (!triangleAlive[t])
+        continue;
+      uint32_t *tri = &indexes[size_t(t) * 3];
+      if (tri[0] == to || tri[1] == to || tri[2] == to) {
+        triangleAlive[t] = 0;
+        --aliveTriangles;
+        continue;
+      }
+      for (int k = 0; k < 3; ++k)
+        if (tri[k] == from)
+          tri[k] = to;
+      vertexTriangles[to].push_back(t);
+    }
+    vertexTriangles[from].clear();
+    quadrics[to] += quadrics[from];
+    removed[from] = 1;
+    ++version[to];
+
+    //> to 주변 edge의 비용을 다시 계산한다.
+    auto &triangles = vertexTriangles[to];
+    triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
+                                   [this](uint32_t t) {
+                                     return !triangleAlive[t];
+                                   }),
+                    triangles.end());
+    for (uint32_t t : triangles) {
+      const uint32_t *tri = &indexes[size_t(t) * 3];
+      for (int k = 0; k < 3; ++k)
+        if (tri[k] != to)
+          PushCandidate(to, tri[k]);
+    }
+  }
+
+  const Mesh &mesh;
+  std::vector<uint32_t> indexes;
+  std::vector<uint32_t> positionIds;
+  std::vector<Quadric> quadrics;
+  std::vector<char> locked;
+  std::vector<char> removed;
+  std::vector<uint32_t> version;
+  std::vector<std::vector<uint32_t>> vertexTriangles;
+  std::vector<char> triangleAlive;
+  size_t aliveTriangles;
+  std::priority_queue<Collapse> heap;
+};
+} // namespace
+
+SimplifyResult MeshSimplifier::Simplify(const Mesh &mesh,
+                                        const SimplifyParams &params) {
+  TOYBOX_PROFILE_SCOPE(profile, "MeshSimplifier::Simplify");
+  CheckIndexes(mesh);
+  Simplifier simplifier(mesh);
+  SimplifyResult result;
+  result.error = simplifier.Run(params);
+  result.mesh = simplifier.Output();
+  TOYBOX_PROFILE_OUTPUT(profile, result.mesh.vertexes.size(),
+                        result.mesh.indexes.size(),
+                        result.mesh.vertexes.size() * sizeof(Vertex) +
+                            result.mesh.indexes.size() * sizeof(uint32_t));
+  return result;
+}
+
+std::vector<LodLevel> MeshSimplifier::BuildLodChain(const Mesh &mesh,
+                                                    size_t levelCount,
+                                                    float ratio,
+                                                    float maxError) {
+  std::vector<LodLevel> levels;
+  CheckIndexes(mesh);
+  if (levelCount == 0)
+    return levels;
+  levels.push_back(LodLevel{mesh, 0.0f});
+
+  //=> 이전 단계에서 이어서 단순화하므로, 오차는 단계별 오차의 합을 상한으로
+  //=> 사용한다.
+  while (levels.size() < levelCount) {
+    const LodLevel &previous = levels.back();
+    size_t triangleCount = previous.mesh.indexes.size() / 3;
+    SimplifyParams params;
+    params.targetTriangleCount = size_t(triangleCount * ratio);
+    params.maxError = maxError - previous.error;
+
+    SimplifyResult result = Simplify(previous.mesh, params);
+    if (result.mesh.indexes.size() / 3 >= triangleCount)
+      break;
+    levels.push_back(
+        LodLevel{std::move(result.mesh), previous.error + result.error});
+  }
+  return levels;
+}
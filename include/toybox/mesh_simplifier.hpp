@@ -0,0 +1,52 @@
+#ifndef TOYBOX_MESH_SIMPLIFIER_H
+#define TOYBOX_MESH_SIMPLIFIER_H
+
+#include <cstddef>
+#include <limits>
+#include <toybox/vertex.hpp>
+#include <vector>
+
+namespace Toybox {
+
+//! 단순화 목표. 두 조건 중 먼저 도달하는 쪽에서 멈춘다.
+struct SimplifyParams {
+  size_t targetTriangleCount;
+  //! 허용하는 최대 오차 (원본 평면들과의 거리, 월드 단위)
+  float maxError = std::numeric_limits<float>::max();
+};
+
+//! 단순화 결과
+struct SimplifyResult {
+  Mesh mesh;
+  float error = 0.0f; // 수행한 collapse 중 가장 큰 오차 (월드 단위)
+};
+
+//! LOD 한 단계
+struct LodLevel {
+  Mesh mesh;
+  //! 원본 대비 누적 오차 상한 (월드 단위). 0단계는 0이다.
+  float error = 0.0f;
+};
+
+//! Quadric error metric 기반 edge collapse로 Mesh를 단순화한다.
+//! - vertex는 새로 만들지 않고 edge의 한쪽 끝으로 합치므로 색상, 법선,
+//!   texcoord가 그대로 유지된다.
+//! - 같은 위치에 vertex가 여러 개 있는 곳(texture seam, 각진 모서리)과
+//!   열린 경계의 vertex는 고정해 모양과 속성 경계를 보존한다.
+//! - 삼각형이 뒤집히는 collapse는 수행하지 않는다.
+//! - vertex 범위를 벗어난 index가 있으면 runtime_error를 던진다.
+class MeshSimplifier {
+public:
+  static SimplifyResult Simplify(const Mesh &mesh,
+                                 const SimplifyParams &params);
+
+  //! 0단계(원본)부터 levelCount개의 LOD를 만든다.
+  //! 각 단계는 이전 단계 삼각형 수의 ratio배를 목표로 한다. 더 줄일 수 없거나
+  //! maxError를 넘으면 그 단계에서 멈추므로 levelCount보다 적을 수 있다.
+  static std::vector<LodLevel>
+  BuildLodChain(const Mesh &mesh, size_t levelCount, float ratio = 0.5f,
+                float maxError = std::numeric_limits<float>::max());
+};
+} // namespace Toybox
+
+#endif
@@ -0,0 +1,57 @@
+#include "toybox/mesh_soa.hpp"
+
+using namespace Toybox;
+
+MeshSoA Toybox::ToSoA(const Mesh &mesh) {
+  MeshSoA soa;
+  const size_t vertexCount = mesh.vertexes.size();
+  soa.Resize(vertexCount);
+
+  float *positions = soa.positions.data();
+  float *colors = soa.colors.data();
+  float *normals = soa.normals.data();
+  float *texcoords = soa.texcoords.data();
+  for (size_t i = 0; i < vertexCount; ++i) {
+    const Vertex &v = mesh.vertexes[i];
+    positions[i * 3] = v.x;
+    positions[i * 3 + 1] = v.y;
+    positions[i * 3 + 2] = v.z;
+    colors[i * 3] = v.r;
+    colors[i * 3 + 1] = v.g;
+    colors[i * 3 + 2] = v.b;
+    normals[i * 3] = v.nx;
+    normals[i * 3 + 1] = v.ny;
+    normals[i * 3 + 2] = v.nz;
+    texcoords[i * 2] = v.tx;
+    texcoords[i * 2 + 1] = v.ty;
+  }
+  soa.indexes = mesh.indexes;
+  return soa;
+}
+
+Mesh Toybox::ToAoS(const MeshSoA &mesh) {
+  Mesh aos;
+  const size_t vertexCount = mesh.VertexCount();
+  aos.vertexes.resize(vertexCount);
+
+  const float *positions = mesh.positions.data();
+  const float *colors = mesh.colors.data();
+  const float *normals = mesh.normals.data();
+  const float *texcoords = mesh.texcoords.data();
+  for (size_t i = 0; i < vertexCount; ++i) {
+    Vertex &v = aos.vertexes[i];
+    v.x = positions[i * 3];
+    v.y = positions[i * 3 + 1];
+    v.z = positions[i * 3 + 2];
+    v.r = colors[i * 3];
+    v.g = colors[i * 3 + 1];
+    v.b = colors[i * 3 + 2];
+    v.nx = normals[i * 3];
+    v.ny = normals[i * 3 + 1];
+    v.nz = normals[i * 3 + 2];
+    v.tx = texcoords[i * 2];
+    v.ty = texcoords[i * 2 + 1];
+  }
+  aos.indexes = mesh.indexes;
+  return aos;
+}
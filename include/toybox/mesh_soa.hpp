@@ -0,0 +1,89 @@
+#ifndef TOYBOX_MESH_SOA_H
+#define TOYBOX_MESH_SOA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <toybox/vertex.hpp>
+#include <vector>
+
+namespace Toybox {
+
+//! 지정한 바이트 경계에 정렬된 메모리를 할당하는 allocator
+template <typename T, std::size_t Alignment = 64> struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    std::size_t bytes = n * sizeof(T);
+    //=> 할당 크기는 정렬 단위의 배수여야 한다.
+    bytes = (bytes + Alignment - 1) / Alignment * Alignment;
+#if defined(_MSC_VER)
+    void *ptr = _aligned_malloc(bytes, Alignment);
+#else
+    void *ptr = std::aligned_alloc(Alignment, bytes);
+#endif
+    if (ptr == nullptr)
+      throw std::bad_alloc();
+    return static_cast<T *>(ptr);
+  }
+
+  void deallocate(T *ptr, std::size_t) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment> &) const noexcept {
+    return false;
+  }
+};
+
+template <typename T> using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+//! 속성별로 분리된 stream에 vertex를 저장하는 Mesh (Structure of Arrays)
+//! - positions: x, y, z
+//! - colors: r, g, b
+//! - normals: nx, ny, nz
+//! - texcoords: tx, ty
+struct MeshSoA {
+  AlignedVector<float> positions;
+  AlignedVector<float> colors;
+  AlignedVector<float> normals;
+  AlignedVector<float> texcoords;
+  std::vector<uint32_t> indexes;
+
+  size_t VertexCount() const { return positions.size() / 3; }
+
+  //! 모든 stream을 vertex 개수에 맞게 조정한다.
+  void Resize(size_t vertexCount) {
+    positions.resize(vertexCount * 3);
+    colors.resize(vertexCount * 3);
+    normals.resize(vertexCount * 3);
+    texcoords.resize(vertexCount * 2);
+  }
+};
+
+//! Interleaved Mesh를 SoA Mesh로 변환한다.
+MeshSoA ToSoA(const Mesh &mesh);
+
+//! SoA Mesh를 Interleaved Mesh로 변환한다.
+Mesh ToAoS(const MeshSoA &mesh);
+} // namespace Toybox
+
+#endif
@@ -0,0 +1,368 @@
+#include "toybox/mesh_welder.hpp"
+#include "toybox/profiler.hpp"
+#include "toybox/thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+using namespace Toybox;
+
+namespace {
+constexpr uint32_t kNoVertex = UINT32_MAX;
+constexpr size_t kMaxComponents = 11;
+//! hash 상위 bit로 나누는 partition 수. partition마다 table을 따로 만든다.
+constexpr size_t kPartitionBits = 8;
+constexpr size_t kPartitionCount = size_t(1) << kPartitionBits;
+
+uint64_t Mix(uint64_t hash, uint64_t value) {
+  hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+  hash ^= hash >> 31;
+  hash *= 0xbf58476d1ce4e5b9ull;
+  return hash ^ (hash >> 29);
+}
+
+//! -0.0을 0.0으로 바꾼 float bit
+uint32_t CanonicalBits(float value) {
+  value += 0.0f;
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+//! mask가 고른 속성의 성분을 차례로 out에 쓰고 성분 수를 반환한다.
+size_t Gather(const Vertex &v, uint32_t mask, float *out) {
+  size_t count = 0;
+  if (mask & ATTR_POSITION) {
+    out[count++] = v.x;
+    out[count++] = v.y;
+    out[count++] = v.z;
+  }
+  if (mask & ATTR_COLOR) {
+    out[count++] = v.r;
+    out[count++] = v.g;
+    out[count++] = v.b;
+  }
+  if (mask & ATTR_NORMAL) {
+    out[count++] = v.nx;
+    out[count++] = v.ny;
+    out[count++] = v.nz;
+  }
+  if (mask & ATTR_TEXCOORD) {
+    out[count++] = v.tx;
+    out[count++] = v.ty;
+  }
+  return count;
+}
+
+//! epsilon 크기 격자의 칸 좌표
+struct Cell {
+  int64_t x;
+  int64_t y;
+  int64_t z;
+  bool operator==(const Cell &other) const {
+    return x == other.x && y == other.y && z == other.z;
+  }
+};
+
+int64_t CellCoordinate(float value, double inverseEpsilon) {
+  //=> 너무 큰 좌표는 가장자리 칸으로 모은다. (int64 변환 overflow 방지)
+  constexpr double kLimit = double(int64_t(1) << 62);
+  double cell = std::floor(double(value) * inverseEpsilon);
+  return int64_t(std::max(-kLimit, std::min(kLimit, cell)));
+}
+
+uint64_t CellHash(const Cell &cell) {
+  return Mix(Mix(Mix(0, uint64_t(cell.x)), uint64_t(cell.y)), uint64_t(cell.z));
+}
+
+size_t PartitionOf(uint64_t hash) {
+  return size_t(hash >> (64 - kPartitionBits));
+}
+
+//! 같은 key(정확한 속성 값 또는 격자 칸)를 갖는 vertex 목록의 open addressing
+//! hash table. vertex를 번호 순서로 넣으므로 목록은 번호 오름차순이다.
+struct PartitionTable {
+  struct Slot {
+    uint32_t first = kNoVertex;
+    uint32_t last = kNoVertex;
+  };
+  std::vector<Slot> slots;
+  size_t mask = 0;
+
+  void Reserve(size_t count) {
+    size_t capacity = 16;
+    while (capacity < count * 2)
+      capacity <<= 1;
+    slots.assign(capacity, Slot());
+    mask = capacity - 1;
+  }
+
+  //! key가 같은 vertex를 갖는 slot. 없으면 빈 slot을 반환한다.
+  template <typename Equal> Slot &Find(uint64_t hash, Equal equal) {
+    for (size_t i = size_t(hash) & mask;; i = (i + 1) & mask) {
+      Slot &slot = slots[i];
+      if (slot.first == kNoVertex || equal(slot.first))
+        return slot;
+    }
+  }
+  //! key가 같은 vertex를 갖는 slot. 없으면 nullptr이다.
+  template <typename Equal>
+  const Slot *Lookup(uint64_t hash, Equal equal) const {
+    if (slots.empty())
+      return nullptr;
+    for (size_t i = size_t(hash) & mask;; i = (i + 1) & mask) {
+      const Slot &slot = slots[i];
+      if (slot.first == kNoVertex)
+        return nullptr;
+      if (equal(slot.first))
+        return &slot;
+    }
+  }
+};
+
+class Welder {
+public:
+  Welder(const Mesh &mesh, const WeldParams &params, ThreadPool *pool)
+      : mesh(mesh), params(params), pool(pool),
+        vertexCount(mesh.vertexes.size()), hashes(vertexCount),
+        representative(vertexCount) {
+    if (params.epsilon > 0.0f) {
+      inverseEpsilon = 1.0 / double(params.epsilon);
+      cells.resize(vertexCount);
+      next.assign(vertexCount, kNoVertex);
+    }
+  }
+
+  //! 이전 vertex 번호 -> 대표 vertex 번호
+  std::vector<uint32_t> Run() {
+    ComputeHashes();
+    Partition();
+    BuildTables();
+    if (params.epsilon > 0.0f)
+      FindNeighbors();
+    return std::move(representative);
+  }
+
+private:
+  bool Exact() const { return params.epsilon <= 0.0f; }
+
+  //! 정확히 비교할 때는 선택한 속성 전체, epsilon이 있을 때는 격자 칸의 hash
+  void ComputeHashes() {
+    ParallelFor(pool, vertexCount, kParallelGrain, [&](size_t begin,
+                                                       size_t end) {
+      float values[kMaxComponents];
+      for (size_t i = begin; i < end; ++i) {
+        const Vertex &v = mesh.vertexes[i];
+        if (Exact()) {
+          size_t count = Gather(v, params.attributeMask, values);
+          uint64_t hash = 0;
+          for (size_t c = 0; c < count; ++c)
+            hash = Mix(hash, CanonicalBits(values[c]));
+          hashes[i] = hash;
+        } else {
+          cells[i] = {CellCoordinate(v.x, inverseEpsilon),
+                      CellCoordinate(v.y, inverseEpsilon),
+                      CellCoordinate(v.z, inverseEpsilon)};
+          hashes[i] = CellHash(cells[i]);
+        }
+      }
+    });
+  }
+
+  //! vertex 번호를 partition별로 모은다. partition 안에서는 번호 오름차순이다.
+  void Partition() {
+    size_t chunkCount = (vertexCount + kParallelGrain - 1) / kParallelGrain;
+    std::vector<uint32_t> counts(chunkCount * kPartitionCount, 0);
+    ParallelFor(pool, chunkCount, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+      for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+        uint32_t *count = &counts[chunk * kPartitionCount];
+        size_t end = std::min(vertexCount, (chunk + 1) * kParallelGrain);
+        for (size_t i = chunk * kParallelGrain; i < end; ++i)
+          ++count[PartitionOf(hashes[i])];
+      }
+    });
+
+    //=> partition 순서, 그 안에서 chunk 순서로 시작 위치를 매긴다.
+    partitionStarts.assign(kPartitionCount + 1, 0);
+    std::vector<uint32_t> offsets(counts.size());
+    uint32_t offset = 0;
+    for (size_t p = 0; p < kPartitionCount; ++p) {
+      partitionStarts[p] = offset;
+      for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        offsets[chunk * kPartitionCount + p] = offset;
+        offset += counts[chunk * kPartitionCount + p];
+      }
+    }
+    partitionStarts[kPartitionCount] = offset;
+
+    order.resize(vertexCount);
+    ParallelFor(pool, chunkCount, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+      for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+        uint32_t *offset = &offsets[chunk * kPartitionCount];
+        size_t end = std::min(vertexCount, (chunk + 1) * kParallelGrain);
+        for (size_t i = chunk * kParallelGrain; i < end; ++i)
+          order[offset[PartitionOf(hashes[i])]++] = uint32_t(i);
+      }
+    });
+  }
+
+  bool SameKey(uint32_t a, uint32_t b) const {
+    if (!Exact())
+      return cells[a] == cells[b];
+    float valuesA[kMaxComponents];
+    float valuesB[kMaxComponents];
+    size_t count = Gather(mesh.vertexes[a], params.attributeMask, valuesA);
+    Gather(mesh.vertexes[b], params.attributeMask, valuesB);
+    for (size_t c = 0; c < count; ++c) {
+      if (CanonicalBits(valuesA[c]) != CanonicalBits(valuesB[c]))
+        return false;
+    }
+    return true;
+  }
+
+  //! partition마다 table을 만든다. 정확히 비교할 때는 여기서 대표가 정해진다.
+  void BuildTables() {
+    tables.resize(kPartitionCount);
+    ParallelFor(pool, kPartitionCount, 1, [&](size_t begin, size_t end) {
+      for (size_t p = begin; p < end; ++p) {
+        PartitionTable &table = tables[p];
+        table.Reserve(partitionStarts[p + 1] - partitionStarts[p]);
+        for (uint32_t i = partitionStarts[p]; i < partitionStarts[p + 1]; ++i) {
+          uint32_t vertex = order[i];
+          PartitionTable::Slot &slot = table.Find(
+              hashes[vertex],
+              [&](uint32_t other) { return SameKey(vertex, other); });
+          if (slot.first == kNoVertex) {
+            slot.first = slot.last = vertex;
+          } else if (!Exact()) {
+            next[slot.last] = vertex;
+            slot.last = vertex;
+          }
+          representative[vertex] = slot.first;
+        }
+      }
+    });
+  }
+
+  bool WithinEpsilon(uint32_t a, uint32_t b) const {
+    float valuesA[kMaxComponents];
+    float valuesB[kMaxComponents];
+    size_t count = Gather(mesh.vertexes[a], params.attributeMask, valuesA);
+    Gather(mesh.vertexes[b], params.attributeMask, valuesB);
+    for (size_t c = 0; c < count; ++c) {
+      if (!(std::fabs(valuesA[c] - valuesB[c]) <= params.epsilon))
+        return false;
+    }
+    return true;
+  }
+
+  //! 주변 27칸에서 epsilon 안에 있는 가장 작은 번호의 vertex를 찾은 뒤,
+  //! 번호 순서로 대표를 따라가 이어진 vertex들이 같은 대표를 갖게 한다.
+  void FindNeighbors() {
+    ParallelFor(pool, vertexCount, kParallelGrain, [&](size_t begin,
+                                                       size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        uint32_t vertex = uint32_t(i);
+        uint32_t best = vertex;
+        for (int dz = -1; dz <= 1; ++dz) {
+          for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+              Cell cell = {cells[i].x + dx, cells[i].y + dy, cells[i].z + dz};
+              uint64_t hash = CellHash(cell);
+              const PartitionTable &table = tables[PartitionOf(hash)];
+              const PartitionTable::Slot *slot = table.Lookup(
+                  hash, [&](uint32_t other) { return cells[other] == cell; });
+              if (slot == nullptr)
+                continue;
+              for (uint32_t other = slot->first; other < best;
+                   other = next[other]) {
+                if (WithinEpsilon(vertex, other)) {
+                  best = other;
+                  break;
+                }
+              }
+            }
+          }
+        }
+        representative[i] = best;
+      }
+    });
+
+    //=> 대표의 번호는 항상 자신보다 작거나 같으므로 한 번 훑으면 충분하다.
+    for (size_t i = 0; i < vertexCount; ++i)
+      representative[i] = representative[representative[i]];
+  }
+
+  const Mesh &mesh;
+  const WeldParams &params;
+  ThreadPool *pool;
+  size_t vertexCount;
+  double inverseEpsilon = 0.0;
+
+  std::vector<uint64_t> hashes;
+  std::vector<Cell> cells;
+  std::vector<uint32_t> next; // 같은 칸의 다음 vertex
+  std::vector<uint32_t> partitionStarts;
+  std::vector<uint32_t> order;
+  std::vector<PartitionTable> tables;
+  std::vector<uint32_t> representative;
+};
+
+WeldResult WeldMesh(Mesh &mesh, const WeldParams &params, ThreadPool *pool,
+                    std::vector<uint32_t> *remap) {
+  TOYBOX_PROFILE_SCOPE(profile, "MeshWelder::Weld");
+  if ((params.attributeMask & ATTR_POSITION) == 0)
+    throw std::runtime_error("용접할 속성에 position이 포함되어야 합니다.");
+  if (!(params.epsilon >= 0.0f) || std::isinf(params.epsilon))
+    throw std::runtime_error("epsilon은 0 이상의 유한한 값이어야 합니다.");
+  if (mesh.vertexes.size() >= size_t(kNoVertex))
+    throw std::runtime_error("vertex 수가 너무 많습니다.");
+  size_t vertexCount = mesh.vertexes.size();
+  for (uint32_t index : mesh.indexes) {
+    if (index >= vertexCount)
+      throw std::runtime_error("index가 vertex 범위를 벗어났습니다.");
+  }
+
+  WeldResult result;
+  result.vertexCountBefore = vertexCount;
+  std::vector<uint32_t> representative = Welder(mesh, params, pool).Run();
+
+  //=> 대표만 원래 순서대로 앞으로 당긴다. 새 번호는 이전 번호 이하이다.
+  std::vector<uint32_t> newIndexes(vertexCount);
+  uint32_t newCount = 0;
+  for (size_t i = 0; i < vertexCount; ++i) {
+    if (representative[i] == i) {
+      newIndexes[i] = newCount;
+      mesh.vertexes[newCount++] = mesh.vertexes[i];
+    } else {
+      newIndexes[i] = newIndexes[representative[i]];
+    }
+  }
+  mesh.vertexes.resize(newCount);
+  mesh.vertexes.shrink_to_fit();
+
+  ParallelFor(pool, mesh.indexes.size(), kParallelGrain, [&](size_t begin,
+                                                             size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      mesh.indexes[i] = newIndexes[mesh.indexes[i]];
+  });
+
+  result.vertexCountAfter = newCount;
+  if (remap != nullptr)
+    *remap = std::move(newIndexes);
+  TOYBOX_PROFILE_OUTPUT(profile, mesh.vertexes.size(), mesh.indexes.size(),
+                        mesh.vertexes.size() * sizeof(Vertex));
+  return result;
+}
+} // namespace
+
+WeldResult MeshWelder::Weld(Mesh &mesh, const WeldParams &params,
+                            std::vector<uint32_t> *remap) {
+  return WeldMesh(mesh, params, nullptr, remap);
+}
+
+WeldResult MeshWelder::Weld(Mesh &mesh, const WeldParams &params,
+                            ThreadPool &pool, std::vector<uint32_t> *remap) {
+  return WeldMesh(mesh, params, &pool, remap);
+}
@@ -0,0 +1,55 @@
+#ifndef TOYBOX_MESH_WELDER_H
+#define TOYBOX_MESH_WELDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <toybox/vertex.hpp>
+#include <toybox/vertex_layout.hpp>
+#include <vector>
+
+namespace Toybox {
+
+class ThreadPool;
+
+//! 합칠 vertex를 고르는 기준
+struct WeldParams {
+  //! 비교할 속성. ATTR_POSITION을 포함해야 한다.
+  //! mask에 없는 속성은 비교하지 않으며, 합쳐진 vertex는 대표 vertex의 값을
+  //! 가진다. (예: ATTR_POSITION | ATTR_NORMAL이면 texture seam도 합친다)
+  uint32_t attributeMask = ATTR_ALL;
+  //! 0이면 선택한 속성이 bit 단위로 같은 vertex만 합친다. (-0.0 == 0.0)
+  //! 0보다 크면 선택한 속성의 모든 성분 차이가 epsilon 이하인 vertex를
+  //! 합친다.
+  float epsilon = 0.0f;
+};
+
+//! 용접 결과
+struct WeldResult {
+  size_t vertexCountBefore = 0;
+  size_t vertexCountAfter = 0;
+
+  size_t RemovedVertexCount() const {
+    return vertexCountBefore - vertexCountAfter;
+  }
+};
+
+//! 같은(또는 가까운) vertex를 하나로 합치고 indexes를 그 자리에서 고친다.
+//! - 각 vertex는 기준을 만족하는 vertex 중 번호가 가장 작은 것(대표)으로
+//!   합쳐지며, 남은 vertex는 원래 순서를 유지한다.
+//! - epsilon > 0에서는 서로 epsilon 안에 이어진 vertex들이 하나로 합쳐질 수
+//!   있으므로, 대표와의 거리가 epsilon보다 클 수 있다.
+//! - 사용되지 않는 vertex도 합칠 뿐 제거하지 않는다.
+//! vertex를 hash 값으로 partition에 나누고 partition마다 open addressing
+//! table을 만든다. 결과는 thread 수와 관계없이 같다.
+class MeshWelder {
+public:
+  //! remap이 nullptr이 아니면 이전 vertex 번호 -> 새 vertex 번호를 기록한다.
+  static WeldResult Weld(Mesh &mesh, const WeldParams &params = WeldParams(),
+                         std::vector<uint32_t> *remap = nullptr);
+  static WeldResult Weld(Mesh &mesh, const WeldParams &params,
+                         ThreadPool &pool,
+                         std::vector<uint32_t> *remap = nullptr);
+};
+} // namespace Toybox
+
+#endif
@@ -0,0 +1,356 @@
+#include "toybox/packed_vertex.hpp"
+#include "toybox/simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(TOYBOX_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+using namespace Toybox;
+
+namespace {
+constexpr float kSnorm16Max = 32767.0f;
+constexpr size_t kVertexFloats = sizeof(Vertex) / sizeof(float);
+
+//! 압축 시 사용하는 position 배율. extent가 0인 축은 항상 0으로 저장한다.
+struct PackScale {
+  float center[3];
+  float invExtent[3];
+
+  explicit PackScale(const PackedBounds &bounds) {
+    for (int a = 0; a < 3; ++a) {
+      center[a] = bounds.center[a];
+      invExtent[a] = bounds.extent[a] > 0.0f ? kSnorm16Max / bounds.extent[a]
+                                             : 0.0f;
+    }
+  }
+};
+
+//=> SIMD 경로와 같은 순서로 clamp 후 round to nearest even 한다.
+int16_t QuantizeSnorm16(float value) {
+  value = std::min(std::max(value, -kSnorm16Max), kSnorm16Max);
+  return int16_t(std::nearbyint(value));
+}
+
+uint8_t QuantizeUnorm8(float value) {
+  value = std::min(std::max(value, 0.0f), 1.0f) * 255.0f;
+  return uint8_t(std::nearbyint(value));
+}
+
+void PackScalar(const Vertex *vertexes, size_t begin, size_t count,
+                const PackScale &scale, PackedVertex *out) {
+  for (size_t i = begin; i < count; ++i) {
+    const Vertex &v = vertexes[i];
+    PackedVertex &p = out[i];
+
+    //> position
+    const float position[3] = {v.x, v.y, v.z};
+    for (int a = 0; a < 3; ++a)
+      p.position[a] =
+          QuantizeSnorm16((position[a] - scale.center[a]) * scale.invExtent[a]);
+    p.position[3] = 0;
+
+    //> normal: 팔면체에 투영한 뒤, 아래쪽 반구는 바깥으로 접는다.
+    float l1 = (std::fabs(v.nx) + std::fabs(v.ny)) + std::fabs(v.nz);
+    float px = 0.0f;
+    float py = 0.0f;
+    if (l1 > 0.0f) {
+      px = v.nx / l1;
+      py = v.ny / l1;
+    }
+    if (v.nz < 0.0f) {
+      float wx = (1.0f - std::fabs(py)) * (px >= 0.0f ? 1.0f : -1.0f);
+      float wy = (1.0f - std::fabs(px)) * (py >= 0.0f ? 1.0f : -1.0f);
+      px = wx;
+      py = wy;
+    }
+    p.normal[0] = QuantizeSnorm16(px * kSnorm16Max);
+    p.normal[1] = QuantizeSnorm16(py * kSnorm16Max);
+
+    //> texcoord, color
+    p.texcoord[0] = VertexPacker::FloatToHalf(v.tx);
+    p.texcoord[1] = VertexPacker::FloatToHalf(v.ty);
+    p.color[0] = QuantizeUnorm8(v.r);
+    p.color[1] = QuantizeUnorm8(v.g);
+    p.color[2] = QuantizeUnorm8(v.b);
+    p.color[3] = 255;
+  }
+}
+
+#if defined(TOYBOX_SIMD_X86)
+//! interleaved vertex 8개에서 같은 속성을 모은다.
+TOYBOX_TARGET_AVX2 __m256 GatherAttribute(const float *base, __m256i offsets,
+                                          int attribute) {
+  return _mm256_i32gather_ps(base + attribute, offsets, 4);
+}
+
+TOYBOX_TARGET_AVX2 __m256i QuantizeSnorm16AVX2(__m256 value) {
+  value = _mm256_min_ps(_mm256_max_ps(value, _mm256_set1_ps(-kSnorm16Max)),
+                        _mm256_set1_ps(kSnorm16Max));
+  return _mm256_cvtps_epi32(value);
+}
+
+TOYBOX_TARGET_AVX2 __m256i QuantizeUnorm8AVX2(__m256 value) {
+  value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()),
+                        _mm256_set1_ps(1.0f));
+  return _mm256_cvtps_epi32(_mm256_mul_ps(value, _mm256_set1_ps(255.0f)));
+}
+
+TOYBOX_TARGET_AVX2 void PackAVX2(const Vertex *vertexes, size_t count,
+                                 const PackScale &scale, PackedVertex *out) {
+  const __m256i offsets = _mm256_mullo_epi32(
+      _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+      _mm256_set1_epi32(int(kVertexFloats)));
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 minusOne = _mm256_set1_ps(-1.0f);
+
+  alignas(32) int32_t position[3][8];
+  alignas(32) int32_t normal[2][8];
+  alignas(32) uint16_t texcoord[2][8];
+  alignas(32) int32_t color[3][8];
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const float *base = &vertexes[i].x;
+
+    //> position
+    for (int a = 0; a < 3; ++a) {
+      __m256 p = GatherAttribute(base, offsets, a);
+      p = _mm256_mul_ps(_mm256_sub_ps(p, _mm256_set1_ps(scale.center[a])),
+                        _mm256_set1_ps(scale.invExtent[a]));
+      _mm256_store_si256(reinterpret_cast<__m256i *>(position[a]),
+                         QuantizeSnorm16AVX2(p));
+    }
+
+    //> normal
+    __m256 nx = GatherAttribute(base, offsets, 6);
+    __m256 ny = GatherAttribute(base, offsets, 7);
+    __m256 nz = GatherAttribute(base, offsets, 8);
+    __m256 l1 = _mm256_add_ps(_mm256_add_ps(_mm256_and_ps(nx, absMask),
+                                            _mm256_and_ps(ny, absMask)),
+                              _mm256_and_ps(nz, absMask));
+    __m256 valid = _mm256_cmp_ps(l1, zero, _CMP_GT_OQ);
+    __m256 px = _mm256_and_ps(_mm256_div_ps(nx, l1), valid);
+    __m256 py = _mm256_and_ps(_mm256_div_ps(ny, l1), valid);
+
+    __m256 signX =
+        _mm256_blendv_ps(minusOne, one, _mm256_cmp_ps(px, zero, _CMP_GE_OQ));
+    __m256 signY =
+        _mm256_blendv_ps(minusOne, one, _mm256_cmp_ps(py, zero, _CMP_GE_OQ));
+    __m256 wx = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_and_ps(py, absMask)),
+                              signX);
+    __m256 wy = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_and_ps(px, absMask)),
+                              signY);
+    __m256 lower = _mm256_cmp_ps(nz, zero, _CMP_LT_OQ);
+    px = _mm256_blendv_ps(px, wx, lower);
+    py = _mm256_blendv_ps(py, wy, lower);
+    _mm256_store_si256(
+        reinterpret_cast<__m256i *>(normal[0]),
+        QuantizeSnorm16AVX2(_mm256_mul_ps(px, _mm256_set1_ps(kSnorm16Max))));
+    _mm256_store_si256(
+        reinterpret_cast<__m256i *>(normal[1]),
+        QuantizeSnorm16AVX2(_mm256_mul_ps(py, _mm256_set1_ps(kSnorm16Max))));
+
+    //> texcoord
+    for (int a = 0; a < 2; ++a) {
+      __m128i half = _mm256_cvtps_ph(GatherAttribute(base, offsets, 9 + a),
+                                     _MM_FROUND_TO_NEAREST_INT);
+      _mm_store_si128(reinterpret_cast<__m128i *>(texcoord[a]), half);
+    }
+
+    //> color
+    for (int a = 0; a < 3; ++a)
+      _mm256_store_si256(
+          reinterpret_cast<__m256i *>(color[a]),
+          QuantizeUnorm8AVX2(GatherAttribute(base, offsets, 3 + a)));
+
+    //=> 계산한 값을 20 byte vertex로 옮긴다.
+    for (int k = 0; k < 8; ++k) {
+      PackedVertex &p = out[i + k];
+      p.position[0] = int16_t(position[0][k]);
+      p.position[1] = int16_t(position[1][k]);
+      p.position[2] = int16_t(position[2][k]);
+      p.position[3] = 0;
+      p.normal[0] = int16_t(normal[0][k]);
+      p.normal[1] = int16_t(normal[1][k]);
+      p.texcoord[0] = texcoord[0][k];
+      p.texcoord[1] = texcoord[1][k];
+      p.color[0] = uint8_t(color[0][k]);
+      p.color[1] = uint8_t(color[1][k]);
+      p.color[2] = uint8_t(color[2][k]);
+      p.color[3] = 255;
+    }
+  }
+  PackScalar(vertexes, i, count, scale, out);
+}
+#endif
+} // namespace
+
+PackedBounds VertexPacker::ComputeBounds(Span<const Vertex> vertexes) {
+  PackedBounds bounds = {};
+  if (vertexes.empty())
+    return bounds;
+
+  float minValue[3] = {vertexes[0].x, vertexes[0].y, vertexes[0].z};
+  float maxValue[3] = {vertexes[0].x, vertexes[0].y, vertexes[0].z};
+  for (const auto &v : vertexes) {
+    const float position[3] = {v.x, v.y, v.z};
+    for (int a = 0; a < 3; ++a) {
+      minValue[a] = std::min(minValue[a], position[a]);
+      maxValue[a] = std::max(maxValue[a], position[a]);
+    }
+  }
+  for (int a = 0; a < 3; ++a) {
+    bounds.center[a] = (minValue[a] + maxValue[a]) * 0.5f;
+    bounds.extent[a] = (maxValue[a] - minValue[a]) * 0.5f;
+  }
+  return bounds;
+}
+
+void VertexPacker::Pack(Span<const Vertex> vertexes, const PackedBounds &bounds,
+                        Span<PackedVertex> out) {
+  if (out.size() < vertexes.size())
+    throw std::runtime_error("PackedVertex buffer 크기가 vertex 개수보다 "
+                             "작습니다.");
+
+  PackScale scale(bounds);
+#if defined(TOYBOX_SIMD_X86)
+  if (DetectSimdLevel() == SIMD_AVX2) {
+    PackAVX2(vertexes.data(), vertexes.size(), scale, out.data());
+    return;
+  }
+#endif
+  PackScalar(vertexes.data(), 0, vertexes.size(), scale, out.data());
+}
+
+PackedMesh VertexPacker::Pack(const Mesh &mesh) {
+  PackedMesh packed;
+  packed.bounds = ComputeBounds(mesh.vertexes);
+  packed.vertexes.resize(mesh.vertexes.size());
+  packed.indexes = mesh.indexes;
+  Pack(mesh.vertexes, packed.bounds, packed.vertexes);
+  return packed;
+}
+
+Vertex VertexPacker::Unpack(const PackedVertex &p, const PackedBounds &bounds) {
+  Vertex v;
+  v.x = bounds.center[0] + bounds.extent[0] * (p.position[0] / kSnorm16Max);
+  v.y = bounds.center[1] + bounds.extent[1] * (p.position[1] / kSnorm16Max);
+  v.z = bounds.center[2] + bounds.extent[2] * (p.position[2] / kSnorm16Max);
+
+  float x = p.normal[0] / kSnorm16Max;
+  float y = p.normal[1] / kSnorm16Max;
+  float z = 1.0f - std::fabs(x) - std::fabs(y);
+  if (z < 0.0f) {
+    float wx = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+    float wy = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+    x = wx;
+    y = wy;
+  }
+  float length = std::sqrt(x * x + y * y + z * z);
+  v.nx = x / length;
+  v.ny = y / length;
+  v.nz = z / length;
+
+  v.tx = HalfToFloat(p.texcoord[0]);
+  v.ty = HalfToFloat(p.texcoord[1]);
+  v.r = p.color[0] / 255.0f;
+  v.g = p.color[1] / 255.0f;
+  v.b = p.color[2] / 255.0f;
+  return v;
+}
+
+Mesh VertexPacker::Unpack(const PackedMesh &mesh) {
+  Mesh result;
+  result.vertexes.resize(mesh.vertexes.size());
+  for (size_t i = 0; i < mesh.vertexes.size(); ++i)
+    result.vertexes[i] = Unpack(mesh.vertexes[i], mesh.bounds);
+  result.indexes = mesh.indexes;
+  return result;
+}
+
+PackErrorStats VertexPacker::MeasureError(const Mesh &mesh,
+                                          const PackedMesh &packed) {
+  PackErrorStats error;
+  size_t count = std::min(mesh.vertexes.size(), packed.vertexes.size());
+  for (size_t i = 0; i < count; ++i) {
+    const Vertex &src = mesh.vertexes[i];
+    Vertex dst = Unpack(packed.vertexes[i], packed.bounds);
+
+    error.position = std::max({error.position, std::fabs(src.x - dst.x),
+                               std::fabs(src.y - dst.y),
+                               std::fabs(src.z - dst.z)});
+    error.texcoord = std::max({error.texcoord, std::fabs(src.tx - dst.tx),
+                               std::fabs(src.ty - dst.ty)});
+    //=> 색상은 [0, 1]로 clamp한 값과 비교한다.
+    const float srcColor[3] = {src.r, src.g, src.b};
+    const float dstColor[3] = {dst.r, dst.g, dst.b};
+    for (int c = 0; c < 3; ++c) {
+      float clamped = std::min(std::max(srcColor[c], 0.0f), 1.0f);
+      error.color = std::max(error.color, std::fabs(clamped - dstColor[c]));
+    }
+
+    //=> 길이가 0인 법선은 방향이 없으므로 제외한다.
+    float length =
+        std::sqrt(src.nx * src.nx + src.ny * src.ny + src.nz * src.nz);
+    if (length > 0.0f) {
+      float dot =
+          (src.nx * dst.nx + src.ny * dst.ny + src.nz * dst.nz) / length;
+      float angle = std::acos(std::min(std::max(dot, -1.0f), 1.0f));
+      error.normal = std::max(error.normal, angle);
+    }
+  }
+  return error;
+}
+
+uint16_t VertexPacker::FloatToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  uint32_t sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  uint32_t half;
+  if (bits >= 0x47800000u) {
+    //=> 65536 이상은 inf, NaN은 quiet NaN
+    half = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+  } else if (bits < 0x38800000u) {
+    //=> half의 subnormal 범위. 0.5f를 더하면 float 덧셈의 반올림(nearest
+    //=> even)으로 mantissa 하위 10bit에 결과가 남는다.
+    float shifted;
+    std::memcpy(&shifted, &bits, sizeof(shifted));
+    shifted += 0.5f;
+    std::memcpy(&half, &shifted, sizeof(half));
+    half -= 0x3F000000u;
+  } else {
+    uint32_t mantissaOdd = (bits >> 13) & 1;
+    bits += (uint32_t(15 - 127) << 23) + 0xFFFu;
+    bits += mantissaOdd;
+    half = bits >> 13;
+  }
+  return uint16_t(half | (sign >> 16));
+}
+
+float VertexPacker::HalfToFloat(uint16_t value) {
+  uint32_t sign = uint32_t(value & 0x8000u) << 16;
+  uint32_t exponent = (value >> 10) & 0x1Fu;
+  uint32_t mantissa = value & 0x3FFu;
+
+  float result;
+  if (exponent == 0) {
+    result = float(mantissa) * (1.0f / 16777216.0f);
+    return sign ? -result : result;
+  }
+
+  uint32_t bits;
+  if (exponent == 31)
+    bits = sign | 0x7F800000u | (mantissa << 13);
+  else
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
@@ -0,0 +1,72 @@
+#ifndef TOYBOX_PACKED_VERTEX_H
+#define TOYBOX_PACKED_VERTEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <toybox/span.hpp>
+#include <toybox/vertex.hpp>
+#include <vector>
+
+namespace Toybox {
+
+//! 20 byte로 압축한 vertex (Toybox::Vertex는 44 byte)
+//! - position: mesh bounds 기준 snorm16. (w는 0, 4 byte 정렬용)
+//! - normal: octahedral 인코딩 snorm16 두 개. 방향만 저장한다.
+//! - texcoord: half float
+//! - color: RGBA8 unorm. (alpha는 255)
+struct PackedVertex {
+  int16_t position[4];
+  int16_t normal[2];
+  uint16_t texcoord[2];
+  uint8_t color[4];
+};
+static_assert(sizeof(PackedVertex) == 20,
+              "PackedVertex는 20 byte여야 합니다.");
+
+//! position 복원용 bounds
+//! position = center + extent * (snorm / 32767)
+struct PackedBounds {
+  float center[3];
+  float extent[3];
+};
+
+struct PackedMesh {
+  std::vector<PackedVertex> vertexes;
+  std::vector<uint32_t> indexes;
+  PackedBounds bounds;
+};
+
+//! 원본과 복원값의 속성별 최대 오차
+struct PackErrorStats {
+  float position = 0.0f; // 좌표 성분별 최대 절대 오차
+  float normal = 0.0f;   // 정규화한 원본 법선과의 최대 각도 (radian)
+  float texcoord = 0.0f; // 성분별 최대 절대 오차
+  float color = 0.0f;    // 성분별 최대 절대 오차
+};
+
+//! Mesh <-> PackedMesh 변환
+class VertexPacker {
+public:
+  static PackedBounds ComputeBounds(Span<const Vertex> vertexes);
+
+  //! vertexes를 out에 압축한다. out 크기는 vertexes 이상이어야 한다.
+  //! CPU가 지원하면 AVX2 / F16C로 8개씩 변환하며, 결과는 scalar 변환과
+  //! 같다.
+  static void Pack(Span<const Vertex> vertexes, const PackedBounds &bounds,
+                   Span<PackedVertex> out);
+  static PackedMesh Pack(const Mesh &mesh);
+
+  static Vertex Unpack(const PackedVertex &vertex, const PackedBounds &bounds);
+  static Mesh Unpack(const PackedMesh &mesh);
+
+  //! 압축 결과를 복원해 원본과 비교한다.
+  static PackErrorStats MeasureError(const Mesh &mesh,
+                                     const PackedMesh &packed);
+
+  //! IEEE 754 half float 변환 (round to nearest even)
+  static uint16_t FloatToHalf(float value);
+  static float HalfToFloat(uint16_t value);
+};
+} // namespace Toybox
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef TOYBOX_PMR_MESH_H
+#define TOYBOX_PMR_MESH_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <toybox/vertex.hpp>
+#include <utility>
+#include <vector>
+
+namespace Toybox {
+
+//! std::pmr::memory_resource에서 할당하는 Mesh
+//! scene 전체를 std::pmr::monotonic_buffer_resource 하나에 만들면 Mesh마다
+//! 해제하지 않고 resource를 정리할 때 한 번에 해제된다.
+//! allocator_type을 가지므로 std::pmr::vector<PmrMesh>에 넣으면 vector와 같은
+//! resource를 사용한다. (복사본은 std::pmr 규칙대로 기본 resource를 쓴다)
+struct PmrMesh {
+  using allocator_type = std::pmr::polymorphic_allocator<Vertex>;
+
+  std::pmr::vector<Vertex> vertexes;
+  std::pmr::vector<uint32_t> indexes;
+
+  PmrMesh() = default;
+  PmrMesh(const PmrMesh &) = default;
+  PmrMesh(PmrMesh &&) = default;
+  PmrMesh &operator=(const PmrMesh &) = default;
+  PmrMesh &operator=(PmrMesh &&) = default;
+
+  explicit PmrMesh(const allocator_type &allocator)
+      : vertexes(allocator), indexes(allocator) {}
+  PmrMesh(const PmrMesh &other, const allocator_type &allocator)
+      : vertexes(other.vertexes, allocator),
+        indexes(other.indexes, allocator) {}
+  PmrMesh(PmrMesh &&other, const allocator_type &allocator)
+      : vertexes(std::move(other.vertexes), allocator),
+        indexes(std::move(other.indexes), allocator) {}
+
+  allocator_type get_allocator() const { return vertexes.get_allocator(); }
+  std::pmr::memory_resource *Resource() const {
+    return vertexes.get_allocator().resource();
+  }
+};
+
+inline Mesh ToMesh(const PmrMesh &mesh) {
+  Mesh result;
+  result.vertexes.assign(mesh.vertexes.begin(), mesh.vertexes.end());
+  result.indexes.assign(mesh.indexes.begin(), mesh.indexes.end());
+  return result;
+}
+
+inline PmrMesh ToPmrMesh(const Mesh &mesh,
+                         std::pmr::memory_resource *resource) {
+  PmrMesh result(resource);
+  result.vertexes.assign(mesh.vertexes.begin(), mesh.vertexes.end());
+  result.indexes.assign(mesh.indexes.begin(), mesh.indexes.end());
+  return result;
+}
+} // namespace Toybox
+
+#endif
@@ -0,0 +1,194 @@
+#include "toybox/primitive_cache.hpp"
+#include <cstring>
+
+using namespace Toybox;
+
+namespace {
+//! float는 bit 값 그대로 key에 넣는다. (-0.0f는 0.0f로 맞춘다.)
+uint64_t FloatWord(float value) {
+  if (value == 0.0f)
+    value = 0.0f;
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+uint64_t PackWord(uint32_t high, uint32_t low) {
+  return (uint64_t(high) << 32) | low;
+}
+
+PrimitiveKey EmptyKey(PrimitiveTypeEnum type) {
+  PrimitiveKey key;
+  key.type = type;
+  for (auto &word : key.words)
+    word = 0;
+  return key;
+}
+} // namespace
+
+bool PrimitiveKey::operator==(const PrimitiveKey &other) const {
+  if (type != other.type)
+    return false;
+  for (size_t i = 0; i < kMaxWords; ++i)
+    if (words[i] != other.words[i])
+      return false;
+  return true;
+}
+
+size_t PrimitiveKeyHash::operator()(const PrimitiveKey &key) const {
+  uint64_t hash = CounterRandom::SplitMix64(uint64_t(key.type));
+  for (auto word : key.words)
+    hash = CounterRandom::SplitMix64(hash ^ word);
+  return size_t(hash);
+}
+
+PrimitiveCache::PrimitiveCache(size_t byteBudget) {
+  stats.byteBudget = byteBudget;
+}
+
+size_t PrimitiveCache::ByteSize(const Mesh &mesh) {
+  return sizeof(Mesh) + mesh.vertexes.capacity() * sizeof(Vertex) +
+         mesh.indexes.capacity() * sizeof(uint32_t);
+}
+
+template <typename Generate>
+std::shared_ptr<const Mesh> PrimitiveCache::Get(const PrimitiveKey &key,
+                                                Generate generate) {
+  if (auto mesh = Find(key))
+    return mesh;
+
+  //=> 생성에 오래 걸릴 수 있으므로 lock 없이 만든 뒤 넣는다.
+  return Insert(key, generate());
+}
+
+std::shared_ptr<const Mesh> PrimitiveCache::Find(const PrimitiveKey &key) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto found = lookup.find(key);
+  if (found == lookup.end()) {
+    ++stats.misses;
+    return nullptr;
+  }
+  ++stats.hits;
+  entries.splice(entries.begin(), entries, found->second);
+  return found->second->mesh;
+}
+
+std::shared_ptr<const Mesh> PrimitiveCache::Insert(const PrimitiveKey &key,
+                                                   Mesh &&mesh) {
+  size_t byteSize = ByteSize(mesh);
+  auto shared = std::make_shared<const Mesh>(std::move(mesh));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  //> 다른 thread가 먼저 같은 Mesh를 넣었으면 그것을 공유한다.
+  auto found = lookup.find(key);
+  if (found != lookup.end()) {
+    entries.splice(entries.begin(), entries, found->second);
+    return found->second->mesh;
+  }
+
+  //> 예산보다 큰 Mesh는 저장하지 않고 돌려준다.
+  if (byteSize > stats.byteBudget)
+    return shared;
+
+  entries.push_front(Entry{key, shared, byteSize});
+  lookup.emplace(key, entries.begin());
+  stats.byteSize += byteSize;
+  stats.entryCount = entries.size();
+  EvictLocked();
+  return shared;
+}
+
+void PrimitiveCache::EvictLocked() {
+  while (stats.byteSize > stats.byteBudget && !entries.empty()) {
+    const Entry &oldest = entries.back();
+    stats.byteSize -= oldest.byteSize;
+    lookup.erase(oldest.key);
+    entries.pop_back();
+    ++stats.evictions;
+  }
+  stats.entryCount = entries.size();
+}
+
+void PrimitiveCache::SetByteBudget(size_t byteBudget) {
+  std::lock_guard<std::mutex> lock(mutex);
+  stats.byteBudget = byteBudget;
+  EvictLocked();
+}
+
+void PrimitiveCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  lookup.clear();
+  entries.clear();
+  stats.byteSize = 0;
+  stats.entryCount = 0;
+}
+
+PrimitiveCacheStats PrimitiveCache::Stats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return stats;
+}
+
+//> 생성 함수별 key 구성
+std::shared_ptr<const Mesh> PrimitiveCache::GetCube(const CubeParams &params) {
+  PrimitiveKey key = EmptyKey(PRIMITIVE_CUBE);
+  key.words[0] = PackWord(params.system, FloatWord(params.sideLength));
+  key.words[1] = params.colorSeed;
+  return Get(key, [&params]() { return Primitives::MakeCube(params); });
+}
+
+std::shared_ptr<const Mesh>
+PrimitiveCache::GetCylinder(const CylinderParams &params) {
+  PrimitiveKey key = EmptyKey(PRIMITIVE_CYLINDER);
+  key.words[0] = PackWord(params.system, FloatWord(params.radius));
+  key.words[1] =
+      PackWord(FloatWord(params.height), FloatWord(params.unitAngle));
+  key.words[2] = params.colorSeed;
+  return Get(key, [&params]() { return Primitives::MakeCylinder(params); });
+}
+
+std::shared_ptr<const Mesh> PrimitiveCache::GetGrid(const GridParams &params) {
+  PrimitiveKey key = EmptyKey(PRIMITIVE_GRID);
+  key.words[0] = PackWord(params.system, FloatWord(params.gridSize));
+  key.words[1] = PackWord(params.xGridLength, params.yGridLength);
+  key.words[2] = params.colorSeed;
+  return Get(key, [&params]() { return Primitives::MakeGrid(params); });
+}
+
+std::shared_ptr<const Mesh>
+PrimitiveCache::GetSandClock(const SandClockParams &params) {
+  PrimitiveKey key = EmptyKey(PRIMITIVE_SANDCLOCK);
+  key.words[0] = params.system;
+  key.words[1] = params.colorSeed;
+  return Get(key, [&params]() { return Primitives::MakeSandClock(params); });
+}
+
+std::shared_ptr<const Mesh>
+PrimitiveCache::GetSphere(const SphereParams &params) {
+  PrimitiveKey key = EmptyKey(PRIMITIVE_SPHERE);
+  key.words[0] = FloatWord(params.radius);
+  key.words[1] = PackWord(params.numSlice, params.numStack);
+  return Get(key, [&params]() { return Primitives::MakeSphere(params); });
+}
+
+std::shared_ptr<const Mesh>
+PrimitiveCache::GetSquare(const SquareParams &params) {
+  return Get(EmptyKey(PRIMITIVE_SQUARE),
+             [&params]() { return Primitives::MakeSquare(params); });
+}
+
+std::shared_ptr<const Mesh> PrimitiveCache::GetAxis(const AxisParams &params) {
+  return Get(EmptyKey(PRIMITIVE_AXIS),
+             [&params]() { return Primitives::MakeAxis(params); });
+}
+
+std::shared_ptr<const Mesh>
+PrimitiveCache::GetFrustum(const FrustumParams &params) {
+  PrimitiveKey key = EmptyKey(PRIMITIVE_FRUSTUM);
+  key.words[0] = PackWord(FloatWord(params.origin[0]),
+                          FloatWord(params.origin[1]));
+  key.words[1] = PackWord(FloatWord(params.origin[2]),
+                          FloatWord(params.fovDegHeight));
+  key.words[2] = PackWord(FloatWord(params.fovDegWidth),
+                          FloatWord(params.farPlaneDistance));
+  return Get(key, [&params]() { return Primitives::MakeFrustum(params); });
+}
@@ -0,0 +1,107 @@
+#ifndef TOYBOX_PRIMITIVE_CACHE_H
+#define TOYBOX_PRIMITIVE_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <toybox/primitives.hpp>
+#include <unordered_map>
+
+namespace Toybox {
+
+enum PrimitiveTypeEnum {
+  PRIMITIVE_CUBE,
+  PRIMITIVE_CYLINDER,
+  PRIMITIVE_GRID,
+  PRIMITIVE_SANDCLOCK,
+  PRIMITIVE_SPHERE,
+  PRIMITIVE_SQUARE,
+  PRIMITIVE_AXIS,
+  PRIMITIVE_FRUSTUM
+};
+
+//! 생성 함수 종류와 입력값(좌표계, seed 포함)으로 만든 cache key
+struct PrimitiveKey {
+  static constexpr size_t kMaxWords = 6;
+
+  PrimitiveTypeEnum type;
+  uint64_t words[kMaxWords];
+
+  bool operator==(const PrimitiveKey &other) const;
+};
+
+struct PrimitiveKeyHash {
+  size_t operator()(const PrimitiveKey &key) const;
+};
+
+//! PrimitiveCache 사용 현황
+struct PrimitiveCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  size_t entryCount = 0;
+  size_t byteSize = 0;
+  size_t byteBudget = 0;
+};
+
+//! 같은 입력값으로 생성된 Mesh를 공유하는 cache.
+//! - 반환된 Mesh는 수정할 수 없으며, cache에서 제거된 뒤에도 참조가 남아
+//!   있는 동안은 유효하다.
+//! - 전체 크기가 byteBudget을 넘으면 가장 오래 사용하지 않은 Mesh부터
+//!   제거한다. (LRU)
+//! - 여러 thread에서 동시에 호출해도 안전하다. 생성은 lock 밖에서 한다.
+class PrimitiveCache {
+public:
+  static constexpr size_t kDefaultByteBudget = 64 * 1024 * 1024;
+
+  explicit PrimitiveCache(size_t byteBudget = kDefaultByteBudget);
+
+  PrimitiveCache(const PrimitiveCache &) = delete;
+  PrimitiveCache &operator=(const PrimitiveCache &) = delete;
+
+  std::shared_ptr<const Mesh> GetCube(const CubeParams &params);
+  std::shared_ptr<const Mesh> GetCylinder(const CylinderParams &params);
+  std::shared_ptr<const Mesh> GetGrid(const GridParams &params);
+  std::shared_ptr<const Mesh> GetSandClock(const SandClockParams &params);
+  std::shared_ptr<const Mesh> GetSphere(const SphereParams &params);
+  std::shared_ptr<const Mesh> GetSquare(const SquareParams &params);
+  std::shared_ptr<const Mesh> GetAxis(const AxisParams &params);
+  std::shared_ptr<const Mesh> GetFrustum(const FrustumParams &params);
+
+  //! 예산을 바꾸고, 넘는 만큼 바로 제거한다.
+  void SetByteBudget(size_t byteBudget);
+
+  //! 모든 Mesh를 제거한다. 통계는 유지된다.
+  void Clear();
+
+  PrimitiveCacheStats Stats() const;
+
+  //! Mesh가 차지하는 메모리 크기 (byte)
+  static size_t ByteSize(const Mesh &mesh);
+
+private:
+  struct Entry {
+    PrimitiveKey key;
+    std::shared_ptr<const Mesh> mesh;
+    size_t byteSize;
+  };
+  using EntryList = std::list<Entry>;
+
+  template <typename Generate>
+  std::shared_ptr<const Mesh> Get(const PrimitiveKey &key, Generate generate);
+
+  std::shared_ptr<const Mesh> Find(const PrimitiveKey &key);
+  std::shared_ptr<const Mesh> Insert(const PrimitiveKey &key, Mesh &&mesh);
+  void EvictLocked();
+
+  mutable std::mutex mutex;
+  EntryList entries; // 앞쪽일수록 최근에 사용
+  std::unordered_map<PrimitiveKey, EntryList::iterator, PrimitiveKeyHash>
+      lookup;
+  PrimitiveCacheStats stats;
+};
+} // namespace Toybox
+
+#endif
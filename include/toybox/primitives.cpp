@@ -1,11 +1,325 @@
 #include "toybox/primitives.hpp"
+#include "toybox/fixed_primitives.hpp"
+#include "toybox/icosphere.hpp"
+#include "toybox/index_buffer.hpp"
+#include "toybox/profiler.hpp"
+#include "toybox/random.hpp"
+#include "toybox/ring_kernel.hpp"
+#include "toybox/thread_pool.hpp"
 #include "toybox/utils.hpp"
+#include <algorithm>
 #include <exception>
+#include <functional>
 #include <stdexcept>
+#include <type_traits>
 
 using namespace Toybox;
 
-Toybox::Mesh Primitives::MakeCube(CoordSystemEnum system, float sideLength) {
+namespace {
+//!  Լ MeshType  vertex/index ϵ ִ writer.
+//!   vertex, index ŭ   Ȯϰ, ġ  .
+//! kHas*  false Ӽ  ʾƵ ȴ.
+template <typename MeshType> class MeshWriter;
+
+//! Vertex ŸԺ Ӽ 
+template <typename VertexType> struct VertexTraits {
+  static constexpr bool kHasColor = VertexType::kHasColor;
+  static constexpr bool kHasNormal = VertexType::kHasNormal;
+  static constexpr bool kHasTexcoord = VertexType::kHasTexcoord;
+};
+
+template <> struct VertexTraits<Toybox::Vertex> {
+  static constexpr bool kHasColor = true;
+  static constexpr bool kHasNormal = true;
+  static constexpr bool kHasTexcoord = true;
+};
+
+//! ̹ Ȯ vertex / index 迭 ϴ writer
+template <typename VertexType, typename IndexType = uint32_t>
+class VertexArrayWriter {
+public:
+  static constexpr bool kHasColor = VertexTraits<VertexType>::kHasColor;
+  static constexpr bool kHasNormal = VertexTraits<VertexType>::kHasNormal;
+  static constexpr bool kHasTexcoord = VertexTraits<VertexType>::kHasTexcoord;
+
+  VertexArrayWriter(VertexType *vertexes, IndexType *indexes)
+      : vertexes(vertexes), indexes(indexes) {}
+
+  void Position(size_t i, float x, float y, float z) {
+    vertexes[i].x = x;
+    vertexes[i].y = y;
+    vertexes[i].z = z;
+  }
+  void Color(size_t i, float r, float g, float b) {
+    detail::SetColor(vertexes[i], r, g, b,
+                     std::integral_constant<bool, kHasColor>());
+  }
+  void Normal(size_t i, float nx, float ny, float nz) {
+    detail::SetNormal(vertexes[i], nx, ny, nz,
+                      std::integral_constant<bool, kHasNormal>());
+  }
+  void Texcoord(size_t i, float tx, float ty) {
+    detail::SetTexcoord(vertexes[i], tx, ty,
+                        std::integral_constant<bool, kHasTexcoord>());
+  }
+  void Index(size_t i, uint32_t value) { indexes[i] = IndexType(value); }
+
+  //! Vertex 迭 [first, first + count) Ѵ.
+  //! VertexType Vertex̸ ״ Ѵ.
+  void CopyVertexes(size_t first, const Toybox::Vertex *source, size_t count) {
+    if constexpr (std::is_same<VertexType, Toybox::Vertex>::value) {
+      std::copy(source, source + count, vertexes + first);
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        const Toybox::Vertex &v = source[i];
+        Position(first + i, v.x, v.y, v.z);
+        Color(first + i, v.r, v.g, v.b);
+        Normal(first + i, v.nx, v.ny, v.nz);
+        Texcoord(first + i, v.tx, v.ty);
+      }
+    }
+  }
+
+  //! [first, first + count) vertex   Ѵ.
+  //! vertex i ä c random.Uniform(3 * i + c)  Ѵ.
+  void RandomColors(size_t first, size_t count, const CounterRandom &random) {
+    if (!kHasColor)
+      return;
+    constexpr size_t kChunk = 256;
+    alignas(32) float rgb[kChunk * 3];
+    for (size_t begin = 0; begin < count; begin += kChunk) {
+      size_t n = std::min(kChunk, count - begin);
+      random.Fill(rgb, n * 3, (first + begin) * 3);
+      for (size_t k = 0; k < n; ++k)
+        Color(first + begin + k, rgb[k * 3], rgb[k * 3 + 1], rgb[k * 3 + 2]);
+    }
+  }
+
+protected:
+  void Reset(VertexType *vertexes, IndexType *indexes) {
+    this->vertexes = vertexes;
+    this->indexes = indexes;
+  }
+
+private:
+  VertexType *vertexes;
+  IndexType *indexes;
+};
+
+template <>
+class MeshWriter<Toybox::Mesh> : public VertexArrayWriter<Toybox::Vertex> {
+public:
+  MeshWriter(Toybox::Mesh &mesh, size_t vertexCount, size_t indexCount)
+      : VertexArrayWriter(nullptr, nullptr) {
+    mesh.vertexes.resize(vertexCount);
+    mesh.indexes.resize(indexCount);
+    Reset(mesh.vertexes.data(), mesh.indexes.data());
+  }
+};
+
+template <>
+class MeshWriter<Toybox::PmrMesh> : public VertexArrayWriter<Toybox::Vertex> {
+public:
+  MeshWriter(Toybox::PmrMesh &mesh, size_t vertexCount, size_t indexCount)
+      : VertexArrayWriter(nullptr, nullptr) {
+    mesh.vertexes.resize(vertexCount);
+    mesh.indexes.resize(indexCount);
+    Reset(mesh.vertexes.data(), mesh.indexes.data());
+  }
+};
+
+template <> class MeshWriter<Toybox::MeshSoA> {
+public:
+  static constexpr bool kHasColor = true;
+  static constexpr bool kHasNormal = true;
+  static constexpr bool kHasTexcoord = true;
+
+  MeshWriter(Toybox::MeshSoA &mesh, size_t vertexCount, size_t indexCount) {
+    mesh.Resize(vertexCount);
+    mesh.indexes.resize(indexCount);
+    positions = mesh.positions.data();
+    colors = mesh.colors.data();
+    normals = mesh.normals.data();
+    texcoords = mesh.texcoords.data();
+    indexes = mesh.indexes.data();
+  }
+
+  void Position(size_t i, float x, float y, float z) {
+    positions[i * 3] = x;
+    positions[i * 3 + 1] = y;
+    positions[i * 3 + 2] = z;
+  }
+  void Color(size_t i, float r, float g, float b) {
+    colors[i * 3] = r;
+    colors[i * 3 + 1] = g;
+    colors[i * 3 + 2] = b;
+  }
+  void Normal(size_t i, float nx, float ny, float nz) {
+    normals[i * 3] = nx;
+    normals[i * 3 + 1] = ny;
+    normals[i * 3 + 2] = nz;
+  }
+  void Texcoord(size_t i, float tx, float ty) {
+    texcoords[i * 2] = tx;
+    texcoords[i * 2 + 1] = ty;
+  }
+  void Index(size_t i, uint32_t value) { indexes[i] = value; }
+
+  void CopyVertexes(size_t first, const Toybox::Vertex *source, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      const Toybox::Vertex &v = source[i];
+      Position(first + i, v.x, v.y, v.z);
+      Color(first + i, v.r, v.g, v.b);
+      Normal(first + i, v.nx, v.ny, v.nz);
+      Texcoord(first + i, v.tx, v.ty);
+    }
+  }
+
+  //! color stream ӵǾ Ƿ  ٷ ä.
+  void RandomColors(size_t first, size_t count, const CounterRandom &random) {
+    random.Fill(colors + first * 3, count * 3, first * 3);
+  }
+
+private:
+  float *positions;
+  float *colors;
+  float *normals;
+  float *texcoords;
+  uint32_t *indexes;
+};
+
+template <uint32_t Mask>
+class MeshWriter<Toybox::LayoutMesh<Mask>>
+    : public VertexArrayWriter<Toybox::LayoutVertex<Mask>> {
+public:
+  MeshWriter(Toybox::LayoutMesh<Mask> &mesh, size_t vertexCount,
+             size_t indexCount)
+      : VertexArrayWriter<Toybox::LayoutVertex<Mask>>(nullptr, nullptr) {
+    mesh.vertexes.resize(vertexCount);
+    mesh.indexes.resize(indexCount);
+    this->Reset(mesh.vertexes.data(), mesh.indexes.data());
+  }
+};
+
+//! IndexBuffer vertex   (16bit / 32bit)  index Ѵ.
+template <>
+class MeshWriter<Toybox::CompactMesh>
+    : public VertexArrayWriter<Toybox::Vertex> {
+public:
+  MeshWriter(Toybox::CompactMesh &mesh, size_t vertexCount, size_t indexCount)
+      : VertexArrayWriter(nullptr, nullptr) {
+    mesh.vertexes.resize(vertexCount);
+    mesh.indexes.Resize(vertexCount, indexCount);
+    Reset(mesh.vertexes.data(), mesh.indexes.Data32());
+    indexes16 = mesh.indexes.Data16();
+    indexes32 = mesh.indexes.Data32();
+  }
+
+  void Index(size_t i, uint32_t value) {
+    if (indexes16 != nullptr)
+      indexes16[i] = uint16_t(value);
+    else
+      indexes32[i] = value;
+  }
+
+private:
+  uint16_t *indexes16;
+  uint32_t *indexes32;
+};
+
+//! Buffer ũⰡ    ܸ .
+//! 16bit index buffer vertex  65536     ִ.
+template <typename VertexType, typename IndexType>
+void CheckBufferSize(Span<VertexType> vertexes, Span<IndexType> indexes,
+                     size_t vertexCount, size_t indexCount) {
+  static_assert(std::is_same<IndexType, uint16_t>::value ||
+                    std::is_same<IndexType, uint32_t>::value,
+                "index uint16_t Ǵ uint32_t մϴ.");
+  if (vertexes.size() < vertexCount || indexes.size() < indexCount)
+    throw std::runtime_error("buffer ũⰡ  vertex/index  "
+                             "۽ϴ.");
+  if (sizeof(IndexType) == sizeof(uint16_t) &&
+      vertexCount > IndexBuffer::kMaxUInt16VertexCount)
+    throw std::runtime_error("vertex   16bit index ǥ  "
+                             "ϴ.");
+}
+
+//!   [0, rowCount) ȿ   ܸ .
+void CheckRowRange(int rowBegin, int rowEnd, int rowCount) {
+  if (rowBegin < 0 || rowBegin > rowEnd || rowEnd > rowCount)
+    throw std::runtime_error("  ü   ϴ.");
+}
+
+//! Vertex    Ӽ Ѵ.
+template <typename Writer>
+void WriteVertex(Writer &writer, size_t i, const Toybox::Vertex &v) {
+  writer.Position(i, v.x, v.y, v.z);
+  writer.Color(i, v.r, v.g, v.b);
+  writer.Normal(i, v.nx, v.ny, v.nz);
+  writer.Texcoord(i, v.tx, v.ty);
+}
+
+//!   table ״ Ѵ.
+template <typename Writer, size_t VertexCount, size_t IndexCount>
+void WriteFixedMesh(Writer &writer,
+                    const FixedMesh<VertexCount, IndexCount> &table) {
+  writer.CopyVertexes(0, table.vertexes.data(), VertexCount);
+  for (size_t i = 0; i < IndexCount; ++i)
+    writer.Index(i, table.indexes[i]);
+}
+
+//! [first, first + count) vertex seed    Ѵ.
+//!  vertex ȣθ ǹǷ   ص  .
+template <typename Writer>
+void WriteRandomColors(Writer &writer, uint64_t seed, size_t first,
+                       size_t count) {
+  if (!Writer::kHasColor)
+    return;
+  writer.RandomColors(first, count, CounterRandom(seed));
+}
+
+//! ring    stack  ũ. ring    Ѵ.
+constexpr int kRingChunk = 256;
+
+#if defined(TOYBOX_ENABLE_PROFILING)
+//!   ϴ byte  ()
+template <typename Allocator>
+size_t IndexByteSize(const std::vector<uint32_t, Allocator> &indexes) {
+  return indexes.size() * sizeof(uint32_t);
+}
+size_t IndexByteSize(const IndexBuffer &indexes) { return indexes.ByteSize(); }
+
+template <typename MeshType> size_t OutputByteSize(const MeshType &mesh) {
+  return mesh.vertexes.size() * sizeof(mesh.vertexes[0]) +
+         IndexByteSize(mesh.indexes);
+}
+size_t OutputByteSize(const MeshSoA &mesh) {
+  return (mesh.positions.size() + mesh.colors.size() + mesh.normals.size() +
+          mesh.texcoords.size()) *
+             sizeof(float) +
+         IndexByteSize(mesh.indexes);
+}
+#endif
+
+//! rowCount  pool  Ѵ.
+//!     ϵǹǷ  ۾  writer Ѵ.
+template <typename Writer, typename BuildRowsFn>
+void BuildRowsParallel(ThreadPool &pool, Writer &writer, int rowCount,
+                       BuildRowsFn buildRows) {
+  std::vector<std::function<void()>> tasks;
+  int grain = std::max(1, rowCount / int(pool.WorkerCount() * 4));
+  for (int row = 0; row < rowCount; row += grain) {
+    int rowEnd = std::min(rowCount, row + grain);
+    tasks.push_back([&writer, &buildRows, row, rowEnd]() {
+      buildRows(writer, row, rowEnd);
+    });
+  }
+  pool.Run(tasks);
+}
+} // namespace
+
+template <typename Writer>
+void Primitives::BuildCube(Writer &writer, const CubeParams &params) {
   /*******************************************************
   Ʒ  vertex index  ť긦 Ѵ.
 
@@ -22,113 +336,30 @@ Toybox::Mesh Primitives::MakeCube(CoordSystemEnum system, float sideLength) {
   - vertex: 6 * 4 = 24
   - indexes: 6 * 6 = 36
   *********************************************************/
-  //> 1. create vertexes
-  int plainLength = 6;
-  int dim = 3;
-  int planePerDim = 2;
-  Toybox::Mesh mesh;
-  std::vector<Toybox::Vertex> vertexes;
-  std::vector<unsigned int> indexes;
-
-  float PI = 3.141592;
-  float PI_DIV_FOUR = 3.141592 / 4;
-  float PI_DIV_TWO = 3.141592 / 2;
-
-  std::vector<int> xList{-1, -1, 1, 1};
-  std::vector<int> yList{-1, 1, 1, -1};
-  std::vector<int> txList{0, 0, 1, 1};
-  std::vector<int> tyList{1, 0, 0, 1};
-  std::vector<int> reversePlane{-1, 1};
-  float x, y;
-
-  //>  
-  for (int i = 0; i < dim; ++i) {
-
-    //=> , 
-    for (auto rev : reversePlane) {
-
-      //=>  ϳ   vertex 
-      for (int k = 0; k < 4; ++k) {
-        Toybox::Vertex vtx;
-
-        if (system == CoordSystemEnum::LEFTHAND) {
-          x = xList[k] * (rev * (-1));
-          y = yList[k];
-        } else {
-          y = xList[k] * (rev * (-1));
-          x = yList[k];
-        }
-
-        //࿡   ä.
-        switch (i) {
-        case 0: // x
-          vtx.x = rev;
-          vtx.y = x;
-          vtx.z = y;
-          // vtx.nx = rev;
-          // vtx.ny = 0;
-          // vtx.nz = 0;
-          break;
-        case 1: // y
-          vtx.y = rev;
-          vtx.z = x;
-          vtx.x = y;
-          // vtx.nx = 0;
-          // vtx.ny = rev;
-          // vtx.nz = 0;
-          break;
-        case 2: // z
-          vtx.z = rev;
-          vtx.x = x;
-          vtx.y = y;
-          // vtx.nx = 0;
-          // vtx.ny = 0;
-          // vtx.nz = rev;
-          break;
-        }
-
-        // ÷ .. 
-        vtx.r = Utils::instance().GetUniformNum();
-        vtx.g = Utils::instance().GetUniformNum();
-        vtx.b = Utils::instance().GetUniformNum();
-
-        // texture ǥ 
-        vtx.tx = txList[k];
-        vtx.ty = tyList[k];
-
-        vtx.x *= (sideLength / 2.0f);
-        vtx.y *= (sideLength / 2.0f);
-        vtx.z *= (sideLength / 2.0f);
-        vtx.nx = vtx.x;
-        vtx.ny = vtx.y;
-        vtx.nz = vtx.z;
-        vertexes.push_back(vtx);
-      }
-    }
-  }
-
-  //> index 
-  for (int planeIndex = 0; planeIndex < 6; ++planeIndex) {
-    // upper triangle
-    indexes.push_back(planeIndex * 4);
-    indexes.push_back(planeIndex * 4 + 1);
-    indexes.push_back(planeIndex * 4 + 2);
-    // lower triangle
-    indexes.push_back(planeIndex * 4);
-    indexes.push_back(planeIndex * 4 + 2);
-    indexes.push_back(planeIndex * 4 + 3);
+  //=> ġ, normal, texcoord   2 cube compile ð table
+  //=> ũ⸸ Ѵ. (normal ġ )
+  const FixedMesh<24, 36> &table = params.system == CoordSystemEnum::LEFTHAND
+                                       ? kFixedCube<LEFTHAND>
+                                       : kFixedCube<LIGHTHAND>;
+  const float scale = params.sideLength / 2.0f;
+  for (size_t i = 0; i < table.vertexes.size(); ++i) {
+    const Vertex &v = table.vertexes[i];
+    writer.Position(i, v.x * scale, v.y * scale, v.z * scale);
+    writer.Normal(i, v.nx * scale, v.ny * scale, v.nz * scale);
+    writer.Texcoord(i, v.tx, v.ty);
   }
+  WriteRandomColors(writer, params.colorSeed, 0, table.vertexes.size());
 
-  mesh.vertexes = vertexes;
-  mesh.indexes = indexes;
-
-  return mesh;
+  for (size_t i = 0; i < table.indexes.size(); ++i)
+    writer.Index(i, table.indexes[i]);
 }
 
-Toybox::Mesh Primitives::MakeGrid(CoordSystemEnum system, int xGridLength,
-                                  int yGridLength, float gridSize) {
+template <typename Writer>
+void Primitives::BuildGridRows(Writer &writer, const GridParams &params,
+                               int rowBegin, int rowEnd) {
   /*******************************************************
   Ʒ  ٵ  grid Ѵ.
+  [rowBegin, rowEnd)  vertex ,  ࿡ ϴ 簢 Ѵ.
 
   +y    +z
   |    /
@@ -141,65 +372,56 @@ Toybox::Mesh Primitives::MakeGrid(CoordSystemEnum system, int xGridLength,
   - vertex : (y grid  + 1) * (x grid  + 1)
   - index : y grid  * x ׸  * 2
   *********************************************************/
-  Toybox::Mesh mesh;
-  std::vector<Toybox::Vertex> vertexes;
-  std::vector<unsigned int> indexes;
-  int indexLength = static_cast<int>(xGridLength * yGridLength);
+  CoordSystemEnum system = params.system;
+  int xGridLength = params.xGridLength;
+  int yGridLength = params.yGridLength;
+  float gridSize = params.gridSize;
 
   //> vertex  ϱ
-  for (int y = 0; y <= yGridLength; ++y) {
-    for (int x = 0; x <= xGridLength; ++x) {
-      Toybox::Vertex v;
+  size_t vertexIndex = size_t(rowBegin) * (xGridLength + 1);
 
+  //=> color
+  WriteRandomColors(writer, params.colorSeed, vertexIndex,
+                    size_t(rowEnd - rowBegin) * (xGridLength + 1));
+  for (int y = rowBegin; y < rowEnd; ++y) {
+    for (int x = 0; x <= xGridLength; ++x, ++vertexIndex) {
       //=> geometry
-      v.x = gridSize * x;
-      v.y = gridSize * y;
-      v.z = 0.0f;
-
-      //=> color
-      v.r = Utils::instance().GetUniformNum();
-      v.g = Utils::instance().GetUniformNum();
-      v.b = Utils::instance().GetUniformNum();
+      writer.Position(vertexIndex, gridSize * x, gridSize * y, 0.0f);
 
       //=> normal
-      v.nx = 0;
-      v.ny = 0;
-      v.nz = system == CoordSystemEnum::LEFTHAND ? -1 : 1;
+      writer.Normal(vertexIndex, 0, 0,
+                    system == CoordSystemEnum::LEFTHAND ? -1 : 1);
 
       //=> texture coord...  ؾұ
       //  ϴ(0,1) 
-      v.tx = static_cast<float>(float(x) / float(yGridLength));
-      v.ty = static_cast<float>(1 - (float(y) / float(yGridLength)));
-      vertexes.push_back(v);
+      writer.Texcoord(vertexIndex,
+                      static_cast<float>(float(x) / float(yGridLength)),
+                      static_cast<float>(1 - (float(y) / float(yGridLength))));
     }
   }
 
   //> index  ϱ
   uint32_t xVertexLength = xGridLength + 1;
-  for (uint32_t y = 0; y < yGridLength; ++y) {
+  uint32_t quadRowEnd = uint32_t(std::min(rowEnd, yGridLength));
+  size_t offset = size_t(rowBegin) * xGridLength * 6;
+  for (uint32_t y = rowBegin; y < quadRowEnd; ++y) {
     uint32_t upperY = (y + 1) * xVertexLength;
     uint32_t crntY = y * xVertexLength;
-    for (uint32_t x = 0; x < xGridLength; ++x) {
-      uint32_t nextX = x + 1;
-
+    for (uint32_t x = 0; x < uint32_t(xGridLength); ++x, offset += 6) {
       // upper triangle
-      indexes.push_back(crntY + x);
-      indexes.push_back(upperY + x);
-      indexes.push_back(upperY + x + 1);
+      writer.Index(offset, crntY + x);
+      writer.Index(offset + 1, upperY + x);
+      writer.Index(offset + 2, upperY + x + 1);
       // lower triangle
-      indexes.push_back(crntY + x);
-      indexes.push_back(upperY + x + 1);
-      indexes.push_back(crntY + x + 1);
+      writer.Index(offset + 3, crntY + x);
+      writer.Index(offset + 4, upperY + x + 1);
+      writer.Index(offset + 5, crntY + x + 1);
     }
   }
-
-  mesh.vertexes = vertexes;
-  mesh.indexes = indexes;
-  return mesh;
 }
 
-Toybox::Mesh Primitives::MakeCylinder(CoordSystemEnum system, float radius,
-                                      float height, float unitAngle) {
+template <typename Writer>
+void Primitives::BuildCylinder(Writer &writer, const CylinderParams &params) {
   /*******************************************************
   Ʒ  ٵ  grid Ѵ.
 
@@ -213,40 +435,41 @@ Toybox::Mesh Primitives::MakeCylinder(CoordSystemEnum system, float radius,
   - vertex : (y grid  + 1) * (x grid  + 1)
   - index : y grid  * x ׸  * 2
   *********************************************************/
-  Toybox::Mesh mesh;
-  std::vector<Toybox::Vertex> vertexes;
-  std::vector<unsigned int> indexes;
+  float height = params.height;
+  float unitAngle = params.unitAngle;
   float unitRadian = unitAngle / 180.0f * 3.141592;
   int circleVertexLength = static_cast<int>(360.0f / unitAngle);
 
+  //=> , Ʒ   sin/cos  ϹǷ   Ѵ.
+  RingTable table(unitRadian, circleVertexLength);
+
   //> vertex  ϱ
+  size_t vertexIndex = 0;
+
+  //=> color
+  WriteRandomColors(writer, params.colorSeed, 0, 2 * circleVertexLength);
   for (int y = 0; y < 2; ++y) {
-    for (int x = 0; x < circleVertexLength; ++x) {
+    for (int x = 0; x < circleVertexLength; ++x, ++vertexIndex) {
       Toybox::Vertex v;
 
       //=> Normal vector , ݽð  ȸѴ.
-      v.x = sin(unitRadian * x);
+      v.x = table.Sin()[x];
       v.y = height * y;
-      v.z = cos(unitRadian * x);
-
-      //=> color
-      v.r = Utils::instance().GetUniformNum();
-      v.g = Utils::instance().GetUniformNum();
-      v.b = Utils::instance().GetUniformNum();
+      v.z = table.Cos()[x];
+      writer.Position(vertexIndex, v.x, v.y, v.z);
 
       //=> normal
       // v.nx = 0;
       // v.ny = y == 0 ? -1 : 1;
       // v.nz = 0;
+      writer.Normal(vertexIndex, v.x, v.y, v.z);
 
-      v.nx = v.x;
-      v.ny = v.y;
-      v.nz = v.z;
       //=> texture coord...  ؾұ
       //  ϴ(0,1) 
-      v.tx = static_cast<float>(float(x) / float(circleVertexLength - 1));
-      v.ty = static_cast<float>(1 - y);
-      vertexes.push_back(v);
+      writer.Texcoord(
+          vertexIndex,
+          static_cast<float>(float(x) / float(circleVertexLength - 1)),
+          static_cast<float>(1 - y));
     }
   }
 
@@ -254,19 +477,16 @@ Toybox::Mesh Primitives::MakeCylinder(CoordSystemEnum system, float radius,
   int nextX;
   for (int x = 0; x < circleVertexLength; ++x) {
     nextX = (x + 1) == circleVertexLength ? 0 : (x + 1);
+    size_t offset = size_t(x) * 6;
     // upper triangle
-    indexes.push_back(x);
-    indexes.push_back(circleVertexLength + x);
-    indexes.push_back(circleVertexLength + nextX);
+    writer.Index(offset, x);
+    writer.Index(offset + 1, circleVertexLength + x);
+    writer.Index(offset + 2, circleVertexLength + nextX);
     // lower triangle
-    indexes.push_back(x);
-    indexes.push_back(circleVertexLength + nextX);
-    indexes.push_back(nextX);
+    writer.Index(offset + 3, x);
+    writer.Index(offset + 4, circleVertexLength + nextX);
+    writer.Index(offset + 5, nextX);
   }
-
-  mesh.vertexes = vertexes;
-  mesh.indexes = indexes;
-  return mesh;
 }
 
 // Toybox::Mesh Primitives::MakeSphere(CoordSystemEnum system) {
@@ -344,7 +564,10 @@ Toybox::Mesh Primitives::MakeCylinder(CoordSystemEnum system, float radius,
 //  return mesh;
 //}
 
-Toybox::Mesh Primitives::MakeSandClock(CoordSystemEnum system) {
+template <typename Writer>
+void Primitives::BuildSandClockRows(Writer &writer,
+                                    const SandClockParams &params, int rowBegin,
+                                    int rowEnd) {
   /*******************************************************
   ü ü Ѵ.
 
@@ -358,10 +581,6 @@ Toybox::Mesh Primitives::MakeSandClock(CoordSystemEnum system) {
   - vertex : (y grid  + 1) * (x grid  + 1)
   - index : y grid  * x ׸  * 2
   *********************************************************/
-  Toybox::Mesh mesh;
-  std::vector<Toybox::Vertex> vertexes;
-  std::vector<unsigned int> indexes;
-
   float PI = 3.141592;
   int vtxStack = 10;
   int horizonStack = 20;
@@ -369,54 +588,62 @@ Toybox::Mesh Primitives::MakeSandClock(CoordSystemEnum system) {
   float vtxUnitRad = PI / vtxStack;
   float horizonUnitRad = (PI * 2.0f) / horizonStack;
 
-  //> vertex  ϱ
-  for (int y = 0; y <= vtxStack; ++y) {
-    float crntY = y * vtxUnit - 1;
-    for (int x = 0; x <= horizonStack; ++x) {
-      Toybox::Vertex v;
-      //=> Normal vector , ݽð  ȸѴ.
-      v.x = cos(horizonUnitRad * x) * cos(vtxUnitRad * y);
-      v.y = crntY;
-      v.z = sin(horizonUnitRad * x) * cos(vtxUnitRad * y);
-
-      //=> color
-      v.r = Utils::instance().GetUniformNum();
-      v.g = Utils::instance().GetUniformNum();
-      v.b = Utils::instance().GetUniformNum();
+  //=>   sin/cos   Ѵ.
+  RingTable table(horizonUnitRad, horizonStack + 1);
+  alignas(32) float ringX[kRingChunk];
+  alignas(32) float ringZ[kRingChunk];
 
-      //=> normal
-      v.nx = v.x;
-      v.ny = v.y;
-      v.nz = v.z;
+  //> vertex  ϱ
+  size_t vertexIndex = size_t(rowBegin) * (horizonStack + 1);
 
-      //=> texture coord...  ؾұ
-      //  ϴ(0,1) 
-      v.tx = static_cast<float>(float(x) / float(horizonStack));
-      v.ty = static_cast<float>(float(y) / float(vtxStack));
-      vertexes.push_back(v);
+  //=> color
+  WriteRandomColors(writer, params.colorSeed, vertexIndex,
+                    size_t(rowEnd - rowBegin) * (horizonStack + 1));
+  for (int y = rowBegin; y < rowEnd; ++y) {
+    float crntY = y * vtxUnit - 1;
+    float ringScale = cos(vtxUnitRad * y);
+    for (int chunk = 0; chunk <= horizonStack; chunk += kRingChunk) {
+      int count = std::min(kRingChunk, horizonStack + 1 - chunk);
+      ComputeRing(table.Cos() + chunk, table.Sin() + chunk, count, ringScale,
+                  ringScale, 0.0f, 0.0f, ringX, ringZ, nullptr, nullptr);
+
+      for (int k = 0; k < count; ++k, ++vertexIndex) {
+        int x = chunk + k;
+        Toybox::Vertex v;
+        //=> Normal vector , ݽð  ȸѴ.
+        v.x = ringX[k];
+        v.y = crntY;
+        v.z = ringZ[k];
+        writer.Position(vertexIndex, v.x, v.y, v.z);
+
+        //=> normal
+        writer.Normal(vertexIndex, v.x, v.y, v.z);
+
+        //=> texture coord...  ؾұ
+        //  ϴ(0,1) 
+        writer.Texcoord(vertexIndex,
+                        static_cast<float>(float(x) / float(horizonStack)),
+                        static_cast<float>(float(y) / float(vtxStack)));
+      }
     }
   }
 
   //> index  ϱ
-  int nextX;
-  for (int y = 0; y < vtxStack; ++y) {
+  size_t offset = size_t(rowBegin) * horizonStack * 6;
+  for (int y = rowBegin; y < std::min(rowEnd, vtxStack); ++y) {
     int crntY = y * (horizonStack + 1);
     int nextY = (y + 1) * (horizonStack + 1);
-    for (int x = 0; x < horizonStack; ++x) {
+    for (int x = 0; x < horizonStack; ++x, offset += 6) {
       //> Upper triangle
-      indexes.push_back(crntY + x);
-      indexes.push_back(nextY + x);
-      indexes.push_back(nextY + x + 1);
+      writer.Index(offset, crntY + x);
+      writer.Index(offset + 1, nextY + x);
+      writer.Index(offset + 2, nextY + x + 1);
       //> Lower triangle
-      indexes.push_back(crntY + x);
-      indexes.push_back(nextY + x + 1);
-      indexes.push_back(crntY + x + 1);
+      writer.Index(offset + 3, crntY + x);
+      writer.Index(offset + 4, nextY + x + 1);
+      writer.Index(offset + 5, crntY + x + 1);
     }
   }
-
-  mesh.vertexes = vertexes;
-  mesh.indexes = indexes;
-  return mesh;
 }
 //
 // Toybox::Mesh Primitives::MakeSphere(
@@ -478,149 +705,110 @@ Toybox::Mesh Primitives::MakeSandClock(CoordSystemEnum system) {
 //  }
 //}
 
-Toybox::Mesh Primitives::MakeSphere(const float radius, const int numSlice,
-                                    const int numStack) {
+template <typename Writer>
+void Primitives::BuildSphereRows(Writer &writer, const SphereParams &params,
+                                 int rowBegin, int rowEnd) {
+  const float radius = params.radius;
+  const int numSlice = params.numSlice;
+  const int numStack = params.numStack;
   const float dTheta = -(3.141592 * 2) / float(numSlice);
   const float dPhi = -3.141592 / float(numStack);
-  Toybox::Mesh object;
+  size_t vertexIndex = size_t(rowBegin) * (numSlice + 1);
+
+  //=> slice  sin/cos  stack Ѵ.
+  RingTable table(dTheta, numSlice + 1);
+  alignas(32) float ringX[kRingChunk];
+  alignas(32) float ringZ[kRingChunk];
+  alignas(32) float normalX[kRingChunk];
+  alignas(32) float normalZ[kRingChunk];
 
-  for (int i = 0; i <= numStack; ++i) {
+  for (int i = rowBegin; i < rowEnd; ++i) {
     Vertex stackStartPoint;
     stackStartPoint.x = (-radius) * (-sin(dPhi * i));
     stackStartPoint.y = (-radius) * cos(dPhi * i);
     stackStartPoint.z = 0;
 
-    for (int j = 0; j <= numSlice; ++j) {
-      Vertex vtx;
-      vtx.x = stackStartPoint.x * cos(dTheta * j);
-      vtx.y = stackStartPoint.y;
-      vtx.z = stackStartPoint.x * (-sin(dTheta * j));
-      float nFactor = sqrt(pow(vtx.x, 2) + pow(vtx.y, 2) + pow(vtx.z, 2));
-      vtx.nx = vtx.x / nFactor;
-      vtx.ny = vtx.y / nFactor;
-      vtx.nz = vtx.z / nFactor;
-      vtx.tx = float(j) / numSlice;
-      vtx.ty = 1.0f - float(i) / numStack;
-      object.vertexes.push_back(vtx);
+    //=> ring    Ÿ  Ƿ stack   Ѵ.
+    float nFactor = sqrt(stackStartPoint.x * stackStartPoint.x +
+                         stackStartPoint.y * stackStartPoint.y);
+    float normalScale = stackStartPoint.x / nFactor;
+    float ny = stackStartPoint.y / nFactor;
+
+    for (int chunk = 0; chunk <= numSlice; chunk += kRingChunk) {
+      int count = std::min(kRingChunk, numSlice + 1 - chunk);
+      ComputeRing(table.Cos() + chunk, table.Sin() + chunk, count,
+                  stackStartPoint.x, -stackStartPoint.x, normalScale,
+                  -normalScale, ringX, ringZ,
+                  Writer::kHasNormal ? normalX : nullptr,
+                  Writer::kHasNormal ? normalZ : nullptr);
+
+      for (int k = 0; k < count; ++k, ++vertexIndex) {
+        int j = chunk + k;
+        writer.Position(vertexIndex, ringX[k], stackStartPoint.y, ringZ[k]);
+        if (Writer::kHasNormal)
+          writer.Normal(vertexIndex, normalX[k], ny, normalZ[k]);
+        writer.Texcoord(vertexIndex, float(j) / numSlice,
+                        1.0f - float(i) / numStack);
+      }
     }
   }
 
-  for (int j = 0; j < numStack; j++) {
+  size_t indexOffset = size_t(rowBegin) * numSlice * 6;
+  for (int j = rowBegin; j < std::min(rowEnd, numStack); j++) {
     const int offset = (numSlice + 1) * j;
-    for (int i = 0; i < numSlice; i++) {
-      object.indexes.push_back(offset + i);
-      object.indexes.push_back(offset + i + numSlice + 1);
-      object.indexes.push_back(offset + i + 1 + numSlice + 1);
-
-      object.indexes.push_back(offset + i);
-      object.indexes.push_back(offset + i + 1 + numSlice + 1);
-      object.indexes.push_back(offset + i + 1);
+    for (int i = 0; i < numSlice; i++, indexOffset += 6) {
+      writer.Index(indexOffset, offset + i);
+      writer.Index(indexOffset + 1, offset + i + numSlice + 1);
+      writer.Index(indexOffset + 2, offset + i + 1 + numSlice + 1);
+
+      writer.Index(indexOffset + 3, offset + i);
+      writer.Index(indexOffset + 4, offset + i + 1 + numSlice + 1);
+      writer.Index(indexOffset + 5, offset + i + 1);
     }
   }
+}
 
-  return object;
+template <typename Writer>
+void Primitives::BuildIcosphere(Writer &writer, const IcosphereParams &params) {
+  //=>    Ѵ. normal   position .
+  //=> useUnitCache false ̹ cache level(PrecomputeIcospheres )
+  //=> cache Ѵ.    useUnitCache  cache ִ´.
+  std::shared_ptr<const UnitIcosphere> unit =
+      params.useUnitCache ? CachedUnitIcosphere(params.level)
+                          : FindCachedUnitIcosphere(params.level);
+  if (!unit)
+    unit = MakeUnitIcosphere(params.level);
+  const float radius = params.radius;
+  const size_t vertexCount = unit->positions.size() / 3;
+  const float *p = unit->positions.data();
+  const float *uv = unit->texcoords.data();
+  for (size_t i = 0; i < vertexCount; ++i, p += 3, uv += 2) {
+    writer.Position(i, radius * p[0], radius * p[1], radius * p[2]);
+    writer.Normal(i, p[0], p[1], p[2]);
+    writer.Texcoord(i, uv[0], uv[1]);
+  }
+  WriteRandomColors(writer, params.colorSeed, 0, vertexCount);
+
+  for (size_t i = 0; i < unit->indexes.size(); ++i)
+    writer.Index(i, unit->indexes[i]);
 }
 
-Toybox::Mesh Primitives::MakeSquare() {
-  Toybox::Mesh mesh;
+template <typename Writer>
+void Primitives::BuildSquare(Writer &writer, const SquareParams &) {
+  WriteFixedMesh(writer, kFixedSquare);
+}
 
-  std::vector<float> xList = {-1.0f, 1.0f, 1.0f, -1.0f};
-  std::vector<float> yList = {1.0f, 1.0f, -1.0f, -1.0f};
-  std::vector<float> xTexcoordList = {0.0f, 1.0f, 1.0f, 0.0f};
-  std::vector<float> yTexcoordList = {0.0f, 0.0f, 1.0f, 1.0f};
-  std::vector<int> indices = {0, 1, 2, 0, 2, 3};
+template <typename Writer>
+void Primitives::BuildAxis(Writer &writer, const AxisParams &) {
+  WriteFixedMesh(writer, kFixedAxis);
+}
 
-  for (int i = 0; i < 4; ++i) {
-    Toybox::Vertex vtx;
-    vtx.x = xList[i];
-    vtx.y = yList[i];
-    vtx.z = 0.0f;
-    vtx.r = 0.0f;
-    vtx.g = 0.0f;
-    vtx.b = 1.0f;
-    vtx.nx = 0.0f;
-    vtx.ny = 0.0f;
-    vtx.nz = -1.0f;
-    vtx.tx = xTexcoordList[i];
-    vtx.ty = yTexcoordList[i];
-    mesh.vertexes.push_back(vtx);
-  }
-
-  for (auto it : indices) {
-    mesh.indexes.push_back(it);
-  }
-
-  return mesh;
-}
-
-Toybox::Mesh Primitives::MakeAxis() {
-  Toybox::Mesh object;
-
-  Vertex red_origin;
-  red_origin.x = 0.0f;
-  red_origin.y = 0.0f;
-  red_origin.z = 0.0f;
-  red_origin.r = 1.0f;
-  red_origin.g = 0.0f;
-  red_origin.b = 0.0f;
-
-  Vertex red;
-  red.x = 1.0f;
-  red.y = 0.0f;
-  red.z = 0.0f;
-  red.r = 1.0f;
-  red.g = 0.0f;
-  red.b = 0.0f;
-
-  Vertex green_origin;
-  green_origin.x = 0.0f;
-  green_origin.y = 0.0f;
-  green_origin.z = 0.0f;
-  green_origin.r = 0.0f;
-  green_origin.g = 1.0f;
-  green_origin.b = 0.0f;
-
-  Vertex green;
-  green.x = 0.0f;
-  green.y = 1.0f;
-  green.z = 0.0f;
-  green.r = 0.0f;
-  green.g = 1.0f;
-  green.b = 0.0f;
-
-  Vertex blue_origin;
-  blue_origin.x = 0.0f;
-  blue_origin.y = 0.0f;
-  blue_origin.z = 0.0f;
-  blue_origin.r = 0.0f;
-  blue_origin.g = 0.0f;
-  blue_origin.b = 1.0f;
-
-  Vertex blue;
-  blue.x = 0.0f;
-  blue.y = 0.0f;
-  blue.z = 1.0f;
-  blue.r = 0.0f;
-  blue.g = 0.0f;
-  blue.b = 1.0f;
-
-  object.vertexes.push_back(red_origin);
-  object.vertexes.push_back(red);
-  object.vertexes.push_back(green_origin);
-  object.vertexes.push_back(green);
-  object.vertexes.push_back(blue_origin);
-  object.vertexes.push_back(blue);
-
-  std::vector<uint32_t> indexes = {0, 1, 2, 3, 4, 5};
-  object.indexes = indexes;
-  return object;
-}
-
-Toybox::Mesh Primitives::MakeFrustum(std::vector<float> origin,
-                                     float fovDegHeight, float fovDegWidth,
-                                     float farPlaneDistance) {
-  if (origin.size() != 3)
-    throw std::runtime_error("origin ǥ 3 Է ʿմϴ.");
+template <typename Writer>
+void Primitives::BuildFrustum(Writer &writer, const FrustumParams &params) {
+  const float *origin = params.origin;
+  float fovDegHeight = params.fovDegHeight;
+  float fovDegWidth = params.fovDegWidth;
+  float farPlaneDistance = params.farPlaneDistance;
 
   float half_height_far_plane =
       Utils::instance().CalcLengthBasedOnFoV(fovDegHeight, farPlaneDistance) /
@@ -630,16 +818,15 @@ Toybox::Mesh Primitives::MakeFrustum(std::vector<float> origin,
       2.f;
 
   //> Far plane Ʈ ϱ
-  std::vector<float> xList = {-half_width_far_plane, half_width_far_plane,
-                              half_width_far_plane, -half_width_far_plane};
-  std::vector<float> yList = {half_height_far_plane, half_height_far_plane,
-                              -half_height_far_plane, -half_height_far_plane};
-  std::vector<float> xTexcoordList = {0.0f, 1.0f, 1.0f, 0.0f};
-  std::vector<float> yTexcoordList = {0.0f, 0.0f, 1.0f, 1.0f};
-
-  Toybox::Mesh object;
+  const float xList[] = {-half_width_far_plane, half_width_far_plane,
+                         half_width_far_plane, -half_width_far_plane};
+  const float yList[] = {half_height_far_plane, half_height_far_plane,
+                         -half_height_far_plane, -half_height_far_plane};
+  const float xTexcoordList[] = {0.0f, 1.0f, 1.0f, 0.0f};
+  const float yTexcoordList[] = {0.0f, 0.0f, 1.0f, 1.0f};
+
   for (int i = 0; i < 4; ++i) {
-    Toybox::Vertex vtx;
+    Toybox::Vertex vtx{};
     vtx.x = xList[i];
     vtx.y = yList[i];
     vtx.z = farPlaneDistance;
@@ -648,21 +835,349 @@ Toybox::Mesh Primitives::MakeFrustum(std::vector<float> origin,
     vtx.b = 1.0f;
     vtx.tx = xTexcoordList[i];
     vtx.ty = yTexcoordList[i];
-    object.vertexes.push_back(vtx);
+    WriteVertex(writer, i, vtx);
   }
 
   //> Origin to Plane  ϱ
-  Toybox::Vertex vtx;
+  Toybox::Vertex vtx{};
   vtx.x = origin[0];
   vtx.y = origin[1];
   vtx.z = origin[2];
   vtx.r = 1.0f;
   vtx.g = 1.0f;
   vtx.b = 1.0f;
-  object.vertexes.push_back(vtx);
+  WriteVertex(writer, 4, vtx);
+
+  const uint32_t indexes[] = {0, 1, 1, 2, 2, 3, 3, 0,
+                              4, 0, 4, 1, 4, 2, 4, 3};
+  for (size_t i = 0; i < 16; ++i)
+    writer.Index(i, indexes[i]);
+}
+
+//>  vertex / index 
+size_t Primitives::VertexCount(const CubeParams &) { return 24; }
+size_t Primitives::IndexCount(const CubeParams &) { return 36; }
+
+size_t Primitives::VertexCount(const CylinderParams &params) {
+  return size_t(static_cast<int>(360.0f / params.unitAngle)) * 2;
+}
+size_t Primitives::IndexCount(const CylinderParams &params) {
+  return size_t(static_cast<int>(360.0f / params.unitAngle)) * 6;
+}
 
-  std::vector<uint32_t> indexes = {0, 1, 1, 2, 2, 3, 3, 0,
-                                   4, 0, 4, 1, 4, 2, 4, 3};
-  object.indexes = indexes;
-  return object;
+size_t Primitives::VertexCount(const GridParams &params) {
+  return size_t(params.xGridLength + 1) * (params.yGridLength + 1);
+}
+size_t Primitives::IndexCount(const GridParams &params) {
+  return size_t(params.xGridLength) * params.yGridLength * 6;
 }
+
+size_t Primitives::VertexCount(const SandClockParams &) { return 11 * 21; }
+size_t Primitives::IndexCount(const SandClockParams &) { return 10 * 20 * 6; }
+
+size_t Primitives::VertexCount(const SphereParams &params) {
+  return size_t(params.numStack + 1) * (params.numSlice + 1);
+}
+size_t Primitives::IndexCount(const SphereParams &params) {
+  return size_t(params.numStack) * params.numSlice * 6;
+}
+
+size_t Primitives::VertexCount(const IcosphereParams &params) {
+  return IcosphereVertexCount(params.level);
+}
+size_t Primitives::IndexCount(const IcosphereParams &params) {
+  return IcosphereIndexCount(params.level);
+}
+
+size_t Primitives::VertexCount(const SquareParams &) { return 4; }
+size_t Primitives::IndexCount(const SquareParams &) { return 6; }
+
+size_t Primitives::VertexCount(const AxisParams &) { return 6; }
+size_t Primitives::IndexCount(const AxisParams &) { return 6; }
+
+size_t Primitives::VertexCount(const FrustumParams &) { return 5; }
+size_t Primitives::IndexCount(const FrustumParams &) { return 16; }
+
+//> ü  ϴ Լ
+int Primitives::RowCount(const GridParams &params) {
+  return params.yGridLength + 1;
+}
+int Primitives::RowCount(const SandClockParams &) { return 11; }
+int Primitives::RowCount(const SphereParams &params) {
+  return params.numStack + 1;
+}
+
+template <typename Writer>
+void Primitives::BuildGrid(Writer &writer, const GridParams &params) {
+  BuildGridRows(writer, params, 0, RowCount(params));
+}
+
+template <typename Writer>
+void Primitives::BuildSandClock(Writer &writer, const SandClockParams &params) {
+  BuildSandClockRows(writer, params, 0, RowCount(params));
+}
+
+template <typename Writer>
+void Primitives::BuildSphere(Writer &writer, const SphereParams &params) {
+  BuildSphereRows(writer, params, 0, RowCount(params));
+}
+
+//>    Լ Է° ü Լ Ѵ.
+template <typename MeshType>
+MeshType Primitives::MakeCube(CoordSystemEnum system, float sideLength) {
+  return MakeCube<MeshType>(CubeParams{system, sideLength});
+}
+
+template <typename MeshType>
+MeshType Primitives::MakeCylinder(CoordSystemEnum system, float radius,
+                                  float height, float unitAngle) {
+  return MakeCylinder<MeshType>(
+      CylinderParams{system, radius, height, unitAngle});
+}
+
+template <typename MeshType>
+MeshType Primitives::MakeGrid(CoordSystemEnum system, int xGridLength,
+                              int yGridLength, float gridSize) {
+  return MakeGrid<MeshType>(
+      GridParams{system, xGridLength, yGridLength, gridSize});
+}
+
+template <typename MeshType>
+MeshType Primitives::MakeSandClock(CoordSystemEnum system) {
+  return MakeSandClock<MeshType>(SandClockParams{system});
+}
+
+template <typename MeshType>
+MeshType Primitives::MakeSphere(const float radius, const int numSlice,
+                                const int numStack) {
+  return MakeSphere<MeshType>(SphereParams{radius, numSlice, numStack});
+}
+
+template <typename MeshType>
+MeshType Primitives::MakeIcosphere(float radius, int level) {
+  return MakeIcosphere<MeshType>(IcosphereParams{radius, level});
+}
+
+void Primitives::PrecomputeIcospheres(int maxLevel) {
+  CachedUnitIcosphere(maxLevel);
+}
+
+void Primitives::ReleaseIcospheres() { ReleaseUnitIcospheres(); }
+
+template <typename MeshType> MeshType Primitives::MakeSquare() {
+  return MakeSquare<MeshType>(SquareParams{});
+}
+
+template <typename MeshType> MeshType Primitives::MakeAxis() {
+  return MakeAxis<MeshType>(AxisParams{});
+}
+
+template <typename MeshType>
+MeshType Primitives::MakeFrustum(std::vector<float> origin, float fovDegHeight,
+                                 float fovDegWidth, float farPlaneDistance) {
+  if (origin.size() != 3)
+    throw std::runtime_error("origin ǥ 3 Է ʿմϴ.");
+
+  return MakeFrustum<MeshType>(
+      FrustumParams{{origin[0], origin[1], origin[2]},
+                    fovDegHeight,
+                    fovDegWidth,
+                    farPlaneDistance});
+}
+
+//> MeshType ϴ Լ buffer ϴ Լ
+#define TOYBOX_DEFINE_PRIMITIVE(Name, Params)                                  \
+  template <typename MeshType>                                                 \
+  MeshType Primitives::Make##Name(const Params &params) {                      \
+    TOYBOX_PROFILE_SCOPE(profile, "Primitives::Make" #Name);                   \
+    MeshType mesh;                                                             \
+    MeshWriter<MeshType> writer(mesh, VertexCount(params),                     \
+                                IndexCount(params));                           \
+    Build##Name(writer, params);                                               \
+    TOYBOX_PROFILE_OUTPUT(profile, VertexCount(params), IndexCount(params),    \
+                          OutputByteSize(mesh));                               \
+    return mesh;                                                               \
+  }                                                                            \
+  PmrMesh Primitives::Make##Name(const Params &params,                         \
+                                 std::pmr::memory_resource *resource) {        \
+    TOYBOX_PROFILE_SCOPE(profile, "Primitives::Make" #Name);                   \
+    PmrMesh mesh(resource);                                                    \
+    MeshWriter<PmrMesh> writer(mesh, VertexCount(params), IndexCount(params)); \
+    Build##Name(writer, params);                                               \
+    TOYBOX_PROFILE_OUTPUT(profile, VertexCount(params), IndexCount(params),    \
+                          OutputByteSize(mesh));                               \
+    return mesh;                                                               \
+  }                                                                            \
+  template <typename VertexType, typename IndexType>                           \
+  void Primitives::Make##Name(const Params &params, Span<VertexType> vertexes, \
+                              Span<IndexType> indexes) {                       \
+    TOYBOX_PROFILE_SCOPE(profile, "Primitives::Make" #Name);                   \
+    CheckBufferSize(vertexes, indexes, VertexCount(params),                    \
+                    IndexCount(params));                                       \
+    VertexArrayWriter<VertexType, IndexType> writer(vertexes.data(),           \
+                                                    indexes.data());           \
+    Build##Name(writer, params);                                               \
+    TOYBOX_PROFILE_OUTPUT(profile, VertexCount(params), IndexCount(params),    \
+                          0);                                                  \
+  }
+
+TOYBOX_DEFINE_PRIMITIVE(Cube, CubeParams)
+TOYBOX_DEFINE_PRIMITIVE(Cylinder, CylinderParams)
+TOYBOX_DEFINE_PRIMITIVE(Grid, GridParams)
+TOYBOX_DEFINE_PRIMITIVE(SandClock, SandClockParams)
+TOYBOX_DEFINE_PRIMITIVE(Sphere, SphereParams)
+TOYBOX_DEFINE_PRIMITIVE(Icosphere, IcosphereParams)
+TOYBOX_DEFINE_PRIMITIVE(Square, SquareParams)
+TOYBOX_DEFINE_PRIMITIVE(Axis, AxisParams)
+TOYBOX_DEFINE_PRIMITIVE(Frustum, FrustumParams)
+
+//>     Լ
+#define TOYBOX_DEFINE_PARALLEL_PRIMITIVE(Name, Params)                         \
+  template <typename MeshType>                                                 \
+  MeshType Primitives::Make##Name(const Params &params, ThreadPool &pool) {    \
+    TOYBOX_PROFILE_SCOPE(profile, "Primitives::Make" #Name);                   \
+    MeshType mesh;                                                             \
+    MeshWriter<MeshType> writer(mesh, VertexCount(params),                     \
+                                IndexCount(params));                           \
+    BuildRowsParallel(pool, writer, RowCount(params),                          \
+                      [&params](auto &w, int begin, int end) {                 \
+                        Build##Name##Rows(w, params, begin, end);              \
+                      });                                                      \
+    TOYBOX_PROFILE_OUTPUT(profile, VertexCount(params), IndexCount(params),    \
+                          OutputByteSize(mesh));                               \
+    return mesh;                                                               \
+  }                                                                            \
+  PmrMesh Primitives::Make##Name(const Params &params, ThreadPool &pool,       \
+                                 std::pmr::memory_resource *resource) {        \
+    TOYBOX_PROFILE_SCOPE(profile, "Primitives::Make" #Name);                   \
+    PmrMesh mesh(resource);                                                    \
+    MeshWriter<PmrMesh> writer(mesh, VertexCount(params), IndexCount(params)); \
+    BuildRowsParallel(pool, writer, RowCount(params),                          \
+                      [&params](auto &w, int begin, int end) {                 \
+                        Build##Name##Rows(w, params, begin, end);              \
+                      });                                                      \
+    TOYBOX_PROFILE_OUTPUT(profile, VertexCount(params), IndexCount(params),    \
+                          OutputByteSize(mesh));                               \
+    return mesh;                                                               \
+  }                                                                            \
+  template <typename VertexType, typename IndexType>                           \
+  void Primitives::Make##Name(const Params &params, Span<VertexType> vertexes, \
+                              Span<IndexType> indexes, ThreadPool &pool) {     \
+    TOYBOX_PROFILE_SCOPE(profile, "Primitives::Make" #Name);                   \
+    CheckBufferSize(vertexes, indexes, VertexCount(params),                    \
+                    IndexCount(params));                                       \
+    VertexArrayWriter<VertexType, IndexType> writer(vertexes.data(),           \
+                                                    indexes.data());           \
+    BuildRowsParallel(pool, writer, RowCount(params),                          \
+                      [&params](auto &w, int begin, int end) {                 \
+                        Build##Name##Rows(w, params, begin, end);              \
+                      });                                                      \
+    TOYBOX_PROFILE_OUTPUT(profile, VertexCount(params), IndexCount(params),    \
+                          0);                                                  \
+  }                                                                            \
+  template <typename VertexType, typename IndexType>                           \
+  void Primitives::Make##Name##Rows(const Params &params,                      \
+                                    Span<VertexType> vertexes,                 \
+                                    Span<IndexType> indexes, int rowBegin,     \
+                                    int rowEnd) {                              \
+    CheckBufferSize(vertexes, indexes, VertexCount(params),                    \
+                    IndexCount(params));                                       \
+    CheckRowRange(rowBegin, rowEnd, RowCount(params));                         \
+    VertexArrayWriter<VertexType, IndexType> writer(vertexes.data(),           \
+                                                    indexes.data());           \
+    Build##Name##Rows(writer, params, rowBegin, rowEnd);                       \
+  }
+
+TOYBOX_DEFINE_PARALLEL_PRIMITIVE(Grid, GridParams)
+TOYBOX_DEFINE_PARALLEL_PRIMITIVE(SandClock, SandClockParams)
+TOYBOX_DEFINE_PARALLEL_PRIMITIVE(Sphere, SphereParams)
+
+//> ϴ MeshType / VertexType   νϽȭѴ.
+#define TOYBOX_INSTANTIATE_PRIMITIVES(MeshType)                                \
+  template MeshType Primitives::MakeCube<MeshType>(CoordSystemEnum, float);    \
+  template MeshType Primitives::MakeCylinder<MeshType>(CoordSystemEnum, float, \
+                                                       float, float);          \
+  template MeshType Primitives::MakeGrid<MeshType>(CoordSystemEnum, int, int,  \
+                                                   float);                     \
+  template MeshType Primitives::MakeSandClock<MeshType>(CoordSystemEnum);      \
+  template MeshType Primitives::MakeSphere<MeshType>(const float, const int,   \
+                                                     const int);               \
+  template MeshType Primitives::MakeIcosphere<MeshType>(float, int);           \
+  template MeshType Primitives::MakeSquare<MeshType>();                        \
+  template MeshType Primitives::MakeAxis<MeshType>();                          \
+  template MeshType Primitives::MakeFrustum<MeshType>(std::vector<float>,      \
+                                                      float, float, float);    \
+  template MeshType Primitives::MakeCube<MeshType>(const CubeParams &);        \
+  template MeshType Primitives::MakeCylinder<MeshType>(const CylinderParams &);\
+  template MeshType Primitives::MakeGrid<MeshType>(const GridParams &);        \
+  template MeshType Primitives::MakeSandClock<MeshType>(                       \
+      const SandClockParams &);                                                \
+  template MeshType Primitives::MakeSphere<MeshType>(const SphereParams &);    \
+  template MeshType Primitives::MakeIcosphere<MeshType>(                       \
+      const IcosphereParams &);                                                \
+  template MeshType Primitives::MakeSquare<MeshType>(const SquareParams &);    \
+  template MeshType Primitives::MakeAxis<MeshType>(const AxisParams &);        \
+  template MeshType Primitives::MakeFrustum<MeshType>(const FrustumParams &);   \
+  template MeshType Primitives::MakeGrid<MeshType>(const GridParams &,         \
+                                                   ThreadPool &);              \
+  template MeshType Primitives::MakeSandClock<MeshType>(                       \
+      const SandClockParams &, ThreadPool &);                                  \
+  template MeshType Primitives::MakeSphere<MeshType>(const SphereParams &,     \
+                                                     ThreadPool &);
+
+#define TOYBOX_INSTANTIATE_BUFFER_PRIMITIVES(VertexType, IndexType)            \
+  template void Primitives::MakeCube<VertexType, IndexType>(                   \
+      const CubeParams &, Span<VertexType>, Span<IndexType>);                  \
+  template void Primitives::MakeCylinder<VertexType, IndexType>(               \
+      const CylinderParams &, Span<VertexType>, Span<IndexType>);              \
+  template void Primitives::MakeGrid<VertexType, IndexType>(                   \
+      const GridParams &, Span<VertexType>, Span<IndexType>);                  \
+  template void Primitives::MakeSandClock<VertexType, IndexType>(              \
+      const SandClockParams &, Span<VertexType>, Span<IndexType>);             \
+  template void Primitives::MakeSphere<VertexType, IndexType>(                 \
+      const SphereParams &, Span<VertexType>, Span<IndexType>);                \
+  template void Primitives::MakeIcosphere<VertexType, IndexType>(              \
+      const IcosphereParams &, Span<VertexType>, Span<IndexType>);             \
+  template void Primitives::MakeSquare<VertexType, IndexType>(                 \
+      const SquareParams &, Span<VertexType>, Span<IndexType>);                \
+  template void Primitives::MakeAxis<VertexType, IndexType>(                   \
+      const AxisParams &, Span<VertexType>, Span<IndexType>);                  \
+  template void Primitives::MakeFrustum<VertexType, IndexType>(                \
+      const FrustumParams &, Span<VertexType>, Span<IndexType>);               \
+  template void Primitives::MakeGrid<VertexType, IndexType>(                   \
+      const GridParams &, Span<VertexType>, Span<IndexType>,                   \
+      ThreadPool &);                                                           \
+  template void Primitives::MakeSandClock<VertexType, IndexType>(              \
+      const SandClockParams &, Span<VertexType>, Span<IndexType>,              \
+      ThreadPool &);                                                           \
+  template void Primitives::MakeSphere<VertexType, IndexType>(                 \
+      const SphereParams &, Span<VertexType>, Span<IndexType>,                 \
+      ThreadPool &);                                                           \
+  template void Primitives::MakeGridRows<VertexType, IndexType>(               \
+      const GridParams &, Span<VertexType>, Span<IndexType>, int, int);        \
+  template void Primitives::MakeSandClockRows<VertexType, IndexType>(          \
+      const SandClockParams &, Span<VertexType>, Span<IndexType>, int, int);   \
+  template void Primitives::MakeSphereRows<VertexType, IndexType>(             \
+      const SphereParams &, Span<VertexType>, Span<IndexType>, int, int);
+
+#define TOYBOX_INSTANTIATE_BUFFERS(VertexType)                                 \
+  TOYBOX_INSTANTIATE_BUFFER_PRIMITIVES(VertexType, uint32_t)                   \
+  TOYBOX_INSTANTIATE_BUFFER_PRIMITIVES(VertexType, uint16_t)
+
+#define TOYBOX_INSTANTIATE_LAYOUT(Mask)                                        \
+  TOYBOX_INSTANTIATE_PRIMITIVES(Toybox::LayoutMesh<Mask>)                      \
+  TOYBOX_INSTANTIATE_BUFFERS(Toybox::LayoutVertex<Mask>)
+
+TOYBOX_INSTANTIATE_PRIMITIVES(Toybox::Mesh)
+TOYBOX_INSTANTIATE_PRIMITIVES(Toybox::MeshSoA)
+TOYBOX_INSTANTIATE_PRIMITIVES(Toybox::CompactMesh)
+TOYBOX_INSTANTIATE_PRIMITIVES(Toybox::PmrMesh)
+TOYBOX_INSTANTIATE_BUFFERS(Toybox::Vertex)
+TOYBOX_INSTANTIATE_LAYOUT(ATTR_POSITION)
+TOYBOX_INSTANTIATE_LAYOUT(ATTR_POSITION | ATTR_COLOR)
+TOYBOX_INSTANTIATE_LAYOUT(ATTR_POSITION | ATTR_NORMAL)
+TOYBOX_INSTANTIATE_LAYOUT(ATTR_POSITION | ATTR_TEXCOORD)
+TOYBOX_INSTANTIATE_LAYOUT(ATTR_POSITION | ATTR_COLOR | ATTR_NORMAL)
+TOYBOX_INSTANTIATE_LAYOUT(ATTR_POSITION | ATTR_COLOR | ATTR_TEXCOORD)
+TOYBOX_INSTANTIATE_LAYOUT(ATTR_POSITION | ATTR_NORMAL | ATTR_TEXCOORD)
+TOYBOX_INSTANTIATE_LAYOUT(ATTR_ALL)
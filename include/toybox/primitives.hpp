@@ -3,29 +3,112 @@
 
 #include <chrono>
 #include <random>
+#include <toybox/index_buffer.hpp>
+#include <toybox/mesh_soa.hpp>
+#include <toybox/pmr_mesh.hpp>
+#include <toybox/random.hpp>
+#include <toybox/span.hpp>
 #include <toybox/vertex.hpp>
+#include <toybox/vertex_layout.hpp>
 #include <vector>
 
 namespace Toybox {
 
+class ThreadPool;
+
 enum CoordSystemEnum { LIGHTHAND, LEFTHAND };
 
+//> 생성 함수별 입력값
+struct CubeParams {
+  CoordSystemEnum system;
+  float sideLength;
+  //! 난수 색상의 seed. 같은 seed면 항상 같은 색상이 생성된다.
+  uint64_t colorSeed = kDefaultRandomSeed;
+};
+
+struct CylinderParams {
+  CoordSystemEnum system;
+  float radius;
+  float height;
+  float unitAngle;
+  //! 난수 색상의 seed. 같은 seed면 항상 같은 색상이 생성된다.
+  uint64_t colorSeed = kDefaultRandomSeed;
+};
+
+struct GridParams {
+  CoordSystemEnum system;
+  int xGridLength;
+  int yGridLength;
+  float gridSize;
+  //! 난수 색상의 seed. 같은 seed면 항상 같은 색상이 생성된다.
+  uint64_t colorSeed = kDefaultRandomSeed;
+};
+
+struct SandClockParams {
+  CoordSystemEnum system;
+  //! 난수 색상의 seed. 같은 seed면 항상 같은 색상이 생성된다.
+  uint64_t colorSeed = kDefaultRandomSeed;
+};
+
+struct SphereParams {
+  float radius;
+  int numSlice;
+  int numStack;
+};
+
+//! MakeIcosphere가 지원하는 최대 level (vertex 약 1000만 개)
+constexpr int kMaxIcosphereLevel = 10;
+
+struct IcosphereParams {
+  float radius;
+  //! 정이십면체를 나누는 횟수. [0, kMaxIcosphereLevel] 범위이다.
+  int level;
+  //! true면 level별 단위 구를 한 번만 만들어 cache에 두고, 이후에는 크기만
+  //! 바꾼다. false여도 이미 cache된 level은 cache를 사용하며, 새로 만든 구를
+  //! cache에 넣지 않을 뿐이다. cache는 ReleaseIcospheres를 호출할 때까지
+  //! 메모리에 남는다.
+  bool useUnitCache = false;
+  //! 난수 색상의 seed. 같은 seed면 항상 같은 색상이 생성된다.
+  uint64_t colorSeed = kDefaultRandomSeed;
+};
+
+struct SquareParams {};
+
+struct AxisParams {};
+
+struct FrustumParams {
+  float origin[3];
+  float fovDegHeight;
+  float fovDegWidth;
+  float farPlaneDistance;
+};
+
+//! 각 Make 함수는 MeshType 템플릿 인자에 따라 결과를 기록한다.
+//! - Toybox::Mesh: interleaved vertex (기본값)
+//! - Toybox::MeshSoA: 속성별 stream
+//! - Toybox::LayoutMesh<Mask>: Mask에 포함된 속성만 생성
+//! - Toybox::CompactMesh: vertex 개수에 따라 16bit / 32bit index로 생성
+//! - Toybox::PmrMesh: std::pmr::memory_resource에서 할당 (기본 resource를
+//!   쓰지 않으려면 resource를 받는 함수를 사용한다)
 class Primitives {
 public:
 public:
   //! Cube 객체를 생성한다.
-  static Toybox::Mesh MakeCube(CoordSystemEnum system, float sideLength);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeCube(CoordSystemEnum system, float sideLength);
 
   //! Square 객체를 생성한다.
   // static Toybox::Mesh MakeSquareLeft();
 
   //! Cylinder 객체를 생성한다.
-  static Toybox::Mesh MakeCylinder(CoordSystemEnum system, float radius,
-                                   float height, float unitAngle);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeCylinder(CoordSystemEnum system, float radius,
+                               float height, float unitAngle);
 
   //! Grid 형태의 판을 생성한다.
-  static Toybox::Mesh MakeGrid(CoordSystemEnum system, int xGridLength,
-                               int yGridLength, float gridSize);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeGrid(CoordSystemEnum system, int xGridLength,
+                           int yGridLength, float gridSize);
 
   //! 구체 만들기
   //static Toybox::Mesh MakeSphere(CoordSystemEnum system);
@@ -36,19 +119,222 @@ public:
   //  const int numStacks);
 
   //! 모래시계 모형 만들기
-  static Toybox::Mesh MakeSandClock(CoordSystemEnum system);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeSandClock(CoordSystemEnum system);
+
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeSphere(const float radius, const int sumSlice,
+                             const int numStack);
+
+  //! 정이십면체를 level번 나눈 구. texture seam과 극점을 빼면 모든 vertex를
+  //! 인접 삼각형이 공유하므로 같은 삼각형 크기에서 UV sphere보다 vertex가
+  //! 적고 극점에 몰리지 않는다. seam의 u는 1을 조금 넘을 수 있다.
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeIcosphere(float radius, int level);
 
-  static Toybox::Mesh MakeSphere(const float radius, const int sumSlice,
-                                 const int numStack);
+  //! [0, maxLevel] level의 단위 icosphere를 미리 만들어 cache에 넣는다.
+  //! 이후 그 level의 MakeIcosphere는 useUnitCache와 관계없이 크기만 바꾼다.
+  static void PrecomputeIcospheres(int maxLevel);
+  //! cache된 단위 icosphere를 모두 해제한다.
+  static void ReleaseIcospheres();
 
-  static Toybox::Mesh MakeSquare();
+  template <typename MeshType = Toybox::Mesh> static MeshType MakeSquare();
 
-  static Toybox::Mesh MakeAxis();
+  template <typename MeshType = Toybox::Mesh> static MeshType MakeAxis();
   
-  static Toybox::Mesh MakeFrustum(std::vector<float> origin, float fovDegHeight, float fovDegWidth, float farPlaneDistance);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeFrustum(std::vector<float> origin, float fovDegHeight, float fovDegWidth, float farPlaneDistance);
 
   //! Subdivision
-  // static Toybox::Mesh MakeSubdivision(Toybox::Mesh& primitive);
+  //! Loop subdivision을 levelCount번 적용한다. 삼각형 하나가 level마다 4개로
+  //! 나뉜다.
+  //! - position과 normal이 같은 vertex는 하나로 보고 매끄럽게 만든다.
+  //!   (texture seam은 갈라지지 않는다)
+  //! - normal이 다른 모서리(cube의 각)와 열린 경계는 crease로 유지한다.
+  //! - color, normal, texcoord는 선형 보간한다.
+  static Toybox::Mesh MakeSubdivision(const Toybox::Mesh &primitive,
+                                      int levelCount = 1);
+  //! level마다 pool에서 병렬로 계산한다. 결과는 단일 thread와 같다.
+  static Toybox::Mesh MakeSubdivision(const Toybox::Mesh &primitive,
+                                      int levelCount, ThreadPool &pool);
+
+public:
+  //! 생성될 vertex 개수를 조회한다.
+  static size_t VertexCount(const CubeParams &params);
+  static size_t VertexCount(const CylinderParams &params);
+  static size_t VertexCount(const GridParams &params);
+  static size_t VertexCount(const SandClockParams &params);
+  static size_t VertexCount(const SphereParams &params);
+  static size_t VertexCount(const IcosphereParams &params);
+  static size_t VertexCount(const SquareParams &params);
+  static size_t VertexCount(const AxisParams &params);
+  static size_t VertexCount(const FrustumParams &params);
+
+  //! 생성될 index 개수를 조회한다.
+  static size_t IndexCount(const CubeParams &params);
+  static size_t IndexCount(const CylinderParams &params);
+  static size_t IndexCount(const GridParams &params);
+  static size_t IndexCount(const SandClockParams &params);
+  static size_t IndexCount(const SphereParams &params);
+  static size_t IndexCount(const IcosphereParams &params);
+  static size_t IndexCount(const SquareParams &params);
+  static size_t IndexCount(const AxisParams &params);
+  static size_t IndexCount(const FrustumParams &params);
+
+  //! 입력값 구조체로 객체를 생성한다.
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeCube(const CubeParams &params);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeCylinder(const CylinderParams &params);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeGrid(const GridParams &params);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeSandClock(const SandClockParams &params);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeSphere(const SphereParams &params);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeIcosphere(const IcosphereParams &params);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeSquare(const SquareParams &params);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeAxis(const AxisParams &params);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeFrustum(const FrustumParams &params);
+
+  //! resource에서 vertex/index를 할당해 객체를 생성한다.
+  //! std::pmr::monotonic_buffer_resource를 넘기면 scene 전체를 malloc/free
+  //! 없이 만들고 한 번에 해제할 수 있다.
+  static PmrMesh MakeCube(const CubeParams &params,
+                          std::pmr::memory_resource *resource);
+  static PmrMesh MakeCylinder(const CylinderParams &params,
+                              std::pmr::memory_resource *resource);
+  static PmrMesh MakeGrid(const GridParams &params,
+                          std::pmr::memory_resource *resource);
+  static PmrMesh MakeSandClock(const SandClockParams &params,
+                               std::pmr::memory_resource *resource);
+  static PmrMesh MakeSphere(const SphereParams &params,
+                            std::pmr::memory_resource *resource);
+  static PmrMesh MakeIcosphere(const IcosphereParams &params,
+                               std::pmr::memory_resource *resource);
+  static PmrMesh MakeSquare(const SquareParams &params,
+                            std::pmr::memory_resource *resource);
+  static PmrMesh MakeAxis(const AxisParams &params,
+                          std::pmr::memory_resource *resource);
+  static PmrMesh MakeFrustum(const FrustumParams &params,
+                             std::pmr::memory_resource *resource);
+
+  //! 호출자가 제공한 buffer(예: mapping된 upload buffer)에 객체를 생성한다.
+  //! 힙 할당과 복사가 없으며, buffer 크기는 VertexCount / IndexCount 이상이어야
+  //! 한다. VertexType은 Toybox::Vertex 또는 Toybox::LayoutVertex<Mask>이다.
+  //! IndexType은 uint32_t 또는 uint16_t이며, uint16_t는 vertex 개수가
+  //! IndexBuffer::kMaxUInt16VertexCount 이하일 때만 사용할 수 있다.
+  template <typename VertexType, typename IndexType>
+  static void MakeCube(const CubeParams &params, Span<VertexType> vertexes,
+                       Span<IndexType> indexes);
+  template <typename VertexType, typename IndexType>
+  static void MakeCylinder(const CylinderParams &params,
+                           Span<VertexType> vertexes, Span<IndexType> indexes);
+  template <typename VertexType, typename IndexType>
+  static void MakeGrid(const GridParams &params, Span<VertexType> vertexes,
+                       Span<IndexType> indexes);
+  template <typename VertexType, typename IndexType>
+  static void MakeSandClock(const SandClockParams &params,
+                            Span<VertexType> vertexes, Span<IndexType> indexes);
+  template <typename VertexType, typename IndexType>
+  static void MakeSphere(const SphereParams &params, Span<VertexType> vertexes,
+                         Span<IndexType> indexes);
+  template <typename VertexType, typename IndexType>
+  static void MakeIcosphere(const IcosphereParams &params,
+                            Span<VertexType> vertexes, Span<IndexType> indexes);
+  template <typename VertexType, typename IndexType>
+  static void MakeSquare(const SquareParams &params, Span<VertexType> vertexes,
+                         Span<IndexType> indexes);
+  template <typename VertexType, typename IndexType>
+  static void MakeAxis(const AxisParams &params, Span<VertexType> vertexes,
+                       Span<IndexType> indexes);
+  template <typename VertexType, typename IndexType>
+  static void MakeFrustum(const FrustumParams &params,
+                          Span<VertexType> vertexes, Span<IndexType> indexes);
+
+  //! 행(stack) 단위로 나누어 pool에서 병렬로 생성한다.
+  //! 결과는 단일 thread 생성 결과와 byte 단위로 동일하다.
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeGrid(const GridParams &params, ThreadPool &pool);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeSandClock(const SandClockParams &params,
+                                ThreadPool &pool);
+  template <typename MeshType = Toybox::Mesh>
+  static MeshType MakeSphere(const SphereParams &params, ThreadPool &pool);
+  static PmrMesh MakeGrid(const GridParams &params, ThreadPool &pool,
+                          std::pmr::memory_resource *resource);
+  static PmrMesh MakeSandClock(const SandClockParams &params, ThreadPool &pool,
+                               std::pmr::memory_resource *resource);
+  static PmrMesh MakeSphere(const SphereParams &params, ThreadPool &pool,
+                            std::pmr::memory_resource *resource);
+
+  template <typename VertexType, typename IndexType>
+  static void MakeGrid(const GridParams &params, Span<VertexType> vertexes,
+                       Span<IndexType> indexes, ThreadPool &pool);
+  template <typename VertexType, typename IndexType>
+  static void MakeSandClock(const SandClockParams &params,
+                            Span<VertexType> vertexes, Span<IndexType> indexes,
+                            ThreadPool &pool);
+  template <typename VertexType, typename IndexType>
+  static void MakeSphere(const SphereParams &params, Span<VertexType> vertexes,
+                         Span<IndexType> indexes, ThreadPool &pool);
+
+  //! 행(stack) 단위로 생성하는 객체의 행 개수
+  static int RowCount(const GridParams &params);
+  static int RowCount(const SandClockParams &params);
+  static int RowCount(const SphereParams &params);
+
+  //! [rowBegin, rowEnd) 행의 vertex와 그 행에서 시작하는 index만 기록한다.
+  //! buffer는 객체 전체 크기여야 하며, 겹치지 않는 행 범위는 여러 thread에서
+  //! 동시에 기록할 수 있다. (큰 객체를 여러 작업으로 나누어 생성할 때 사용)
+  template <typename VertexType, typename IndexType>
+  static void MakeGridRows(const GridParams &params, Span<VertexType> vertexes,
+                           Span<IndexType> indexes, int rowBegin, int rowEnd);
+  template <typename VertexType, typename IndexType>
+  static void MakeSandClockRows(const SandClockParams &params,
+                                Span<VertexType> vertexes,
+                                Span<IndexType> indexes, int rowBegin,
+                                int rowEnd);
+  template <typename VertexType, typename IndexType>
+  static void MakeSphereRows(const SphereParams &params,
+                             Span<VertexType> vertexes, Span<IndexType> indexes,
+                             int rowBegin, int rowEnd);
+
+private:
+  //> 실제 생성 로직. Writer를 통해 vertex/index를 기록한다.
+  template <typename Writer>
+  static void BuildCube(Writer &writer, const CubeParams &params);
+  template <typename Writer>
+  static void BuildCylinder(Writer &writer, const CylinderParams &params);
+  template <typename Writer>
+  static void BuildGrid(Writer &writer, const GridParams &params);
+  template <typename Writer>
+  static void BuildSandClock(Writer &writer, const SandClockParams &params);
+  template <typename Writer>
+  static void BuildSphere(Writer &writer, const SphereParams &params);
+  template <typename Writer>
+  static void BuildIcosphere(Writer &writer, const IcosphereParams &params);
+  template <typename Writer>
+  static void BuildSquare(Writer &writer, const SquareParams &params);
+  template <typename Writer>
+  static void BuildAxis(Writer &writer, const AxisParams &params);
+  template <typename Writer>
+  static void BuildFrustum(Writer &writer, const FrustumParams &params);
+
+  //> [rowBegin, rowEnd) 범위의 행만 기록하는 생성 로직
+  template <typename Writer>
+  static void BuildGridRows(Writer &writer, const GridParams &params,
+                            int rowBegin, int rowEnd);
+  template <typename Writer>
+  static void BuildSandClockRows(Writer &writer, const SandClockParams &params,
+                                 int rowBegin, int rowEnd);
+  template <typename Writer>
+  static void BuildSphereRows(Writer &writer, const SphereParams &params,
+                              int rowBegin, int rowEnd);
 };
 } // namespace Toybox
 
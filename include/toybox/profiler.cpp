@@ -0,0 +1,247 @@
+#include "toybox/profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+using namespace Toybox;
+
+namespace {
+//! trace event 하나. name은 ProfileSite의 문자열 상수를 가리킨다.
+struct TraceEvent {
+  const char *name;
+  uint64_t beginNs;
+  uint64_t durationNs;
+  uint32_t threadId;
+  uint64_t vertexCount;
+  uint64_t indexCount;
+};
+
+//! 등록된 측정 지점과 trace event 저장소
+struct ProfilerState {
+  std::atomic<ProfileSite *> sites{nullptr};
+
+  std::atomic<bool> traceEnabled{false};
+  std::mutex traceMutex;
+  std::vector<TraceEvent> events;
+  size_t maxEvents = Profiler::kDefaultMaxTraceEvents;
+  size_t droppedEvents = 0;
+};
+
+ProfilerState &State() {
+  static ProfilerState state;
+  return state;
+}
+
+//! thread마다 0부터 차례로 붙이는 번호 (trace의 tid)
+uint32_t CurrentThreadId() {
+  static std::atomic<uint32_t> nextId(0);
+  thread_local uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+  return id;
+}
+
+size_t HistogramBucket(uint64_t durationNs) {
+  size_t bucket = 0;
+  while (durationNs > 1 && bucket + 1 < kProfileHistogramBuckets) {
+    durationNs >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void AtomicMin(std::atomic<uint64_t> &target, uint64_t value) {
+  uint64_t current = target.load(std::memory_order_relaxed);
+  while (value < current &&
+         !target.compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+void AtomicMax(std::atomic<uint64_t> &target, uint64_t value) {
+  uint64_t current = target.load(std::memory_order_relaxed);
+  while (value > current &&
+         !target.compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+//! JSON 문자열 안에 넣을 수 있도록 escape한다.
+std::string EscapeJson(const char *text) {
+  std::string result;
+  for (const char *c = text; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\')
+      result += '\\';
+    result += *c;
+  }
+  return result;
+}
+} // namespace
+
+//> ProfileSite
+ProfileSite::ProfileSite(const char *name) : name(name), next(nullptr) {
+  Reset();
+  Profiler::Register(this);
+}
+
+void ProfileSite::Reset() {
+  callCount.store(0, std::memory_order_relaxed);
+  totalNs.store(0, std::memory_order_relaxed);
+  minNs.store(UINT64_MAX, std::memory_order_relaxed);
+  maxNs.store(0, std::memory_order_relaxed);
+  for (auto &bucket : histogram)
+    bucket.store(0, std::memory_order_relaxed);
+  vertexCount.store(0, std::memory_order_relaxed);
+  indexCount.store(0, std::memory_order_relaxed);
+  byteCount.store(0, std::memory_order_relaxed);
+}
+
+void ProfileSite::Record(uint64_t beginNs, uint64_t durationNs,
+                         uint64_t vertexCount, uint64_t indexCount,
+                         uint64_t byteCount) {
+  callCount.fetch_add(1, std::memory_order_relaxed);
+  totalNs.fetch_add(durationNs, std::memory_order_relaxed);
+  AtomicMin(minNs, durationNs);
+  AtomicMax(maxNs, durationNs);
+  histogram[HistogramBucket(durationNs)].fetch_add(1,
+                                                   std::memory_order_relaxed);
+  this->vertexCount.fetch_add(vertexCount, std::memory_order_relaxed);
+  this->indexCount.fetch_add(indexCount, std::memory_order_relaxed);
+  this->byteCount.fetch_add(byteCount, std::memory_order_relaxed);
+
+  if (State().traceEnabled.load(std::memory_order_relaxed))
+    Profiler::AddTraceEvent(*this, beginNs, durationNs, vertexCount,
+                            indexCount);
+}
+
+//> Profiler
+void Profiler::Register(ProfileSite *site) {
+  std::atomic<ProfileSite *> &head = State().sites;
+  site->next = head.load(std::memory_order_relaxed);
+  while (!head.compare_exchange_weak(site->next, site,
+                                     std::memory_order_release,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+std::vector<ProfileStats> Profiler::Snapshot() {
+  std::map<std::string, ProfileStats> merged;
+  for (ProfileSite *site = State().sites.load(std::memory_order_acquire);
+       site != nullptr; site = site->next) {
+    uint64_t callCount = site->callCount.load(std::memory_order_relaxed);
+    if (callCount == 0)
+      continue;
+    ProfileStats &stats = merged[site->name];
+    uint64_t minNs = site->minNs.load(std::memory_order_relaxed);
+    uint64_t maxNs = site->maxNs.load(std::memory_order_relaxed);
+    stats.minNs = stats.callCount == 0 ? minNs : std::min(stats.minNs, minNs);
+    stats.maxNs = std::max(stats.maxNs, maxNs);
+    stats.name = site->name;
+    stats.callCount += callCount;
+    stats.totalNs += site->totalNs.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kProfileHistogramBuckets; ++i)
+      stats.histogram[i] += site->histogram[i].load(std::memory_order_relaxed);
+    stats.vertexCount += site->vertexCount.load(std::memory_order_relaxed);
+    stats.indexCount += site->indexCount.load(std::memory_order_relaxed);
+    stats.byteCount += site->byteCount.load(std::memory_order_relaxed);
+  }
+
+  std::vector<ProfileStats> result;
+  result.reserve(merged.size());
+  for (auto &entry : merged)
+    result.push_back(entry.second);
+  return result;
+}
+
+void Profiler::Reset() {
+  for (ProfileSite *site = State().sites.load(std::memory_order_acquire);
+       site != nullptr; site = site->next)
+    site->Reset();
+
+  ProfilerState &state = State();
+  std::lock_guard<std::mutex> lock(state.traceMutex);
+  state.events.clear();
+  state.droppedEvents = 0;
+}
+
+void Profiler::EnableTrace(bool enabled, size_t maxEvents) {
+  ProfilerState &state = State();
+  {
+    std::lock_guard<std::mutex> lock(state.traceMutex);
+    state.maxEvents = maxEvents;
+  }
+  state.traceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::TraceEnabled() {
+  return State().traceEnabled.load(std::memory_order_relaxed);
+}
+
+size_t Profiler::DroppedTraceEvents() {
+  ProfilerState &state = State();
+  std::lock_guard<std::mutex> lock(state.traceMutex);
+  return state.droppedEvents;
+}
+
+void Profiler::AddTraceEvent(const ProfileSite &site, uint64_t beginNs,
+                             uint64_t durationNs, uint64_t vertexCount,
+                             uint64_t indexCount) {
+  TraceEvent event = {site.name,        beginNs,    durationNs,
+                      CurrentThreadId(), vertexCount, indexCount};
+  ProfilerState &state = State();
+  std::lock_guard<std::mutex> lock(state.traceMutex);
+  if (state.events.size() >= state.maxEvents) {
+    ++state.droppedEvents;
+    return;
+  }
+  state.events.push_back(event);
+}
+
+std::string Profiler::ChromeTraceJson() {
+  ProfilerState &state = State();
+  std::vector<TraceEvent> events;
+  {
+    std::lock_guard<std::mutex> lock(state.traceMutex);
+    events = state.events;
+  }
+
+  //=> 시각은 microsecond 단위이며 첫 event를 0으로 둔다.
+  uint64_t originNs = UINT64_MAX;
+  for (const TraceEvent &event : events)
+    originNs = std::min(originNs, event.beginNs);
+
+  std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  char buffer[256];
+  for (size_t i = 0; i < events.size(); ++i) {
+    const TraceEvent &event = events[i];
+    std::snprintf(buffer, sizeof(buffer),
+                  "%s\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+                  "\"dur\":%.3f,\"args\":{\"vertices\":%llu,"
+                  "\"indices\":%llu},\"name\":\"",
+                  i == 0 ? "" : ",", event.threadId,
+                  double(event.beginNs - originNs) / 1000.0,
+                  double(event.durationNs) / 1000.0,
+                  (unsigned long long)event.vertexCount,
+                  (unsigned long long)event.indexCount);
+    json += buffer;
+    json += EscapeJson(event.name);
+    json += "\"}";
+  }
+  json += "\n]}\n";
+  return json;
+}
+
+void Profiler::WriteChromeTrace(const std::string &path) {
+  std::ofstream file(path, std::ios::binary);
+  file << ChromeTraceJson();
+  if (!file)
+    throw std::runtime_error("trace 파일을 쓸 수 없습니다: " + path);
+}
+
+uint64_t Profiler::NowNs() {
+  return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count());
+}
@@ -0,0 +1,145 @@
+#ifndef TOYBOX_PROFILER_H
+#define TOYBOX_PROFILER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Toybox {
+
+//! 호출 시간 histogram의 칸 수
+constexpr size_t kProfileHistogramBuckets = 32;
+
+//! 측정 지점(생성 함수 등) 하나의 누적 통계
+struct ProfileStats {
+  std::string name;
+  uint64_t callCount = 0;
+  uint64_t totalNs = 0;
+  uint64_t minNs = 0;
+  uint64_t maxNs = 0;
+  //! histogram[i]: 걸린 시간이 [2^i, 2^(i+1)) ns인 호출 수.
+  //! 마지막 칸은 그보다 긴 호출을 모두 포함한다.
+  uint64_t histogram[kProfileHistogramBuckets] = {};
+  uint64_t vertexCount = 0; // 생성한 vertex 수의 합
+  uint64_t indexCount = 0;  // 생성한 index 수의 합
+  uint64_t byteCount = 0;   // 결과를 담기 위해 할당한 byte 수의 합
+
+  double MeanNs() const {
+    return callCount == 0 ? 0.0 : double(totalNs) / double(callCount);
+  }
+};
+
+//! 측정 지점 하나. TOYBOX_PROFILE_SCOPE가 호출 위치마다 static으로 만든다.
+//! 처음 만들어질 때 Profiler에 등록되며, 기록은 lock 없이 atomic으로 한다.
+class ProfileSite {
+public:
+  explicit ProfileSite(const char *name);
+
+  ProfileSite(const ProfileSite &) = delete;
+  ProfileSite &operator=(const ProfileSite &) = delete;
+
+  const char *Name() const { return name; }
+
+  void Record(uint64_t beginNs, uint64_t durationNs, uint64_t vertexCount,
+              uint64_t indexCount, uint64_t byteCount);
+
+private:
+  friend class Profiler;
+
+  void Reset();
+
+  const char *name;
+  ProfileSite *next; // 등록된 지점의 단일 연결 list
+  std::atomic<uint64_t> callCount;
+  std::atomic<uint64_t> totalNs;
+  std::atomic<uint64_t> minNs;
+  std::atomic<uint64_t> maxNs;
+  std::atomic<uint64_t> histogram[kProfileHistogramBuckets];
+  std::atomic<uint64_t> vertexCount;
+  std::atomic<uint64_t> indexCount;
+  std::atomic<uint64_t> byteCount;
+};
+
+//! 측정 결과 조회와 Chrome trace 출력.
+//! TOYBOX_ENABLE_PROFILING이 정의되지 않으면 측정 지점이 compile되지 않으므로
+//! Snapshot은 비어 있다.
+class Profiler {
+public:
+  static constexpr size_t kDefaultMaxTraceEvents = 1 << 20;
+
+  //! 모든 측정 지점의 통계. 이름이 같은 지점(MeshType별 instance 등)은
+  //! 합치며, 결과는 이름 순서이다.
+  static std::vector<ProfileStats> Snapshot();
+
+  //! 통계와 기록된 trace event를 모두 지운다.
+  static void Reset();
+
+  //! 호출마다 trace event를 기록할지 정한다. 기본값은 기록하지 않음이다.
+  //! maxEvents를 넘는 event는 버리고 DroppedTraceEvents로 센다.
+  static void EnableTrace(bool enabled,
+                          size_t maxEvents = kDefaultMaxTraceEvents);
+  static bool TraceEnabled();
+  static size_t DroppedTraceEvents();
+
+  //! 기록된 event를 Chrome trace JSON(chrome://tracing, Perfetto)으로 만든다.
+  static std::string ChromeTraceJson();
+  //! 파일을 쓸 수 없으면 예외를 던진다.
+  static void WriteChromeTrace(const std::string &path);
+
+  //! 측정에 사용하는 단조 증가 시각 (ns)
+  static uint64_t NowNs();
+
+private:
+  friend class ProfileSite;
+  static void Register(ProfileSite *site);
+  static void AddTraceEvent(const ProfileSite &site, uint64_t beginNs,
+                            uint64_t durationNs, uint64_t vertexCount,
+                            uint64_t indexCount);
+};
+
+//! 생성 시점부터 소멸 시점까지를 site에 기록한다.
+class ProfileScope {
+public:
+  explicit ProfileScope(ProfileSite &site)
+      : site(site), beginNs(Profiler::NowNs()) {}
+  ~ProfileScope() {
+    site.Record(beginNs, Profiler::NowNs() - beginNs, vertexCount, indexCount,
+                byteCount);
+  }
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+  //! 이 호출이 만든 결과의 크기
+  void SetOutput(size_t vertexCount, size_t indexCount, size_t byteCount) {
+    this->vertexCount = vertexCount;
+    this->indexCount = indexCount;
+    this->byteCount = byteCount;
+  }
+
+private:
+  ProfileSite &site;
+  uint64_t beginNs;
+  uint64_t vertexCount = 0;
+  uint64_t indexCount = 0;
+  uint64_t byteCount = 0;
+};
+} // namespace Toybox
+
+//> 측정 macro. TOYBOX_ENABLE_PROFILING이 없으면 아무 코드도 만들지 않는다.
+//! - TOYBOX_PROFILE_SCOPE(scope, "name"): 현재 block의 실행 시간을 기록한다.
+//! - TOYBOX_PROFILE_OUTPUT(scope, vertexes, indexes, bytes): 결과 크기 기록
+#if defined(TOYBOX_ENABLE_PROFILING)
+#define TOYBOX_PROFILE_SCOPE(scope, name)                                      \
+  static Toybox::ProfileSite scope##Site(name);                                \
+  Toybox::ProfileScope scope(scope##Site)
+#define TOYBOX_PROFILE_OUTPUT(scope, vertexes, indexes, bytes)                 \
+  scope.SetOutput(vertexes, indexes, bytes)
+#else
+#define TOYBOX_PROFILE_SCOPE(scope, name)
+#define TOYBOX_PROFILE_OUTPUT(scope, vertexes, indexes, bytes) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+#include "toybox/random.hpp"
+#include "toybox/simd.hpp"
+
+#if defined(TOYBOX_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+using namespace Toybox;
+
+namespace {
+void FillScalar(const CounterRandom &random, float *out, size_t begin,
+                size_t count, uint64_t firstCounter) {
+  for (size_t i = begin; i < count; ++i)
+    out[i] = random.Uniform(firstCounter + i);
+}
+
+#if defined(TOYBOX_SIMD_X86)
+TOYBOX_TARGET_AVX2 __m256i Mix32AVX2(__m256i x) {
+  x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+  x = _mm256_mullo_epi32(x, _mm256_set1_epi32(0x7FEB352D));
+  x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+  x = _mm256_mullo_epi32(x, _mm256_set1_epi32(int(0x846CA68Bu)));
+  x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+  return x;
+}
+
+//! 부호 없는 32bit 비교. a < b인 lane은 -1, 아니면 0
+TOYBOX_TARGET_AVX2 __m256i LessUnsignedAVX2(__m256i a, __m256i b) {
+  const __m256i bias = _mm256_set1_epi32(int(0x80000000u));
+  return _mm256_cmpgt_epi32(_mm256_xor_si256(b, bias),
+                            _mm256_xor_si256(a, bias));
+}
+
+TOYBOX_TARGET_AVX2 void FillAVX2(const CounterRandom &random, float *out,
+                                 size_t count, uint64_t firstCounter) {
+  const uint64_t key = random.Key();
+  const __m256i keyLo = _mm256_set1_epi32(int(uint32_t(key)));
+  const __m256i keyHi = _mm256_set1_epi32(int(uint32_t(key >> 32)));
+  const __m256i laneOffset = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256 scale = _mm256_set1_ps(1.0f / 16777216.0f);
+
+  //=> counter를 하위 / 상위 32bit로 나누어 들고, 하위가 넘치면 상위에
+  //=> 올림을 더한다. (비교 결과 -1을 빼면 1이 더해진다)
+  const __m256i first = _mm256_set1_epi32(int(uint32_t(firstCounter)));
+  __m256i counterLo = _mm256_add_epi32(first, laneOffset);
+  __m256i counterHi =
+      _mm256_sub_epi32(_mm256_set1_epi32(int(uint32_t(firstCounter >> 32))),
+                       LessUnsignedAVX2(counterLo, first));
+  const __m256i step = _mm256_set1_epi32(8);
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i x = Mix32AVX2(_mm256_xor_si256(counterLo, keyLo));
+    x = Mix32AVX2(_mm256_add_epi32(x, _mm256_xor_si256(counterHi, keyHi)));
+    __m256 value = _mm256_cvtepi32_ps(_mm256_srli_epi32(x, 8));
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(value, scale));
+
+    __m256i next = _mm256_add_epi32(counterLo, step);
+    counterHi = _mm256_sub_epi32(counterHi, LessUnsignedAVX2(next, counterLo));
+    counterLo = next;
+  }
+  FillScalar(random, out, i, count, firstCounter);
+}
+#endif
+} // namespace
+
+void CounterRandom::Fill(float *out, size_t count,
+                         uint64_t firstCounter) const {
+#if defined(TOYBOX_SIMD_X86)
+  if (DetectSimdLevel() == SIMD_AVX2) {
+    FillAVX2(*this, out, count, firstCounter);
+    return;
+  }
+#endif
+  FillScalar(*this, out, 0, count, firstCounter);
+}
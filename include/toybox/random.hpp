@@ -0,0 +1,68 @@
+#ifndef TOYBOX_RANDOM_H
+#define TOYBOX_RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Toybox {
+
+//! seed를 지정하지 않았을 때 사용하는 값
+constexpr uint64_t kDefaultRandomSeed = 0x5EED7B0C5EED7B0Cull;
+
+//! Counter 기반 난수 생성기 (SplitMix 방식).
+//! 내부 상태가 없고 (seed, stream, counter)만으로 값이 결정되므로
+//! - 실행할 때마다 같은 결과가 나오고
+//! - 여러 thread가 하나의 객체를 동시에 사용해도 안전하며
+//! - 임의 위치의 값을 순서와 관계없이 계산할 수 있다.
+class CounterRandom {
+public:
+  constexpr explicit CounterRandom(uint64_t seed = kDefaultRandomSeed,
+                                   uint64_t stream = 0)
+      : key(SplitMix64(seed ^ SplitMix64(stream + 0x632BE59BD9B4E019ull))) {}
+
+  //! 같은 seed에서 독립적인 stream을 만든다. (thread별, 호출별 stream 용도)
+  constexpr CounterRandom Stream(uint64_t stream) const {
+    return CounterRandom(key, stream);
+  }
+
+  //! counter 위치의 32bit 난수. counter의 상위 32bit도 hash에 섞으므로
+  //! 2^32 간격으로 값이 반복되지 않는다.
+  constexpr uint32_t Bits(uint64_t counter) const {
+    return Mix32(Mix32(uint32_t(counter) ^ uint32_t(key)) +
+                 (uint32_t(counter >> 32) ^ uint32_t(key >> 32)));
+  }
+
+  //! counter 위치의 [0, 1) 균등분포 난수
+  constexpr float Uniform(uint64_t counter) const {
+    return float(Bits(counter) >> 8) * (1.0f / 16777216.0f);
+  }
+
+  //! out[i] = Uniform(firstCounter + i)를 count개 채운다.
+  //! CPU가 지원하면 AVX2로 8개씩 계산한다.
+  void Fill(float *out, size_t count, uint64_t firstCounter) const;
+
+  static constexpr uint64_t SplitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+  }
+
+  //! 32bit 정수 hash. SIMD의 32bit 곱셈으로 그대로 옮길 수 있다.
+  static constexpr uint32_t Mix32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+  }
+
+  uint64_t Key() const { return key; }
+
+private:
+  uint64_t key;
+};
+} // namespace Toybox
+
+#endif
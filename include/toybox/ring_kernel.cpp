@@ -0,0 +1,127 @@
+#include "toybox/ring_kernel.hpp"
+#include <cmath>
+
+#if defined(TOYBOX_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+using namespace Toybox;
+
+namespace {
+void ComputeRingScalar(const float *cosTable, const float *sinTable,
+                       size_t begin, size_t count, float cosScale,
+                       float sinScale, float normalCosScale,
+                       float normalSinScale, float *outCos, float *outSin,
+                       float *normalCos, float *normalSin) {
+  for (size_t j = begin; j < count; ++j) {
+    outCos[j] = cosScale * cosTable[j];
+    outSin[j] = sinScale * sinTable[j];
+  }
+  if (normalCos == nullptr || normalSin == nullptr)
+    return;
+  for (size_t j = begin; j < count; ++j) {
+    normalCos[j] = normalCosScale * cosTable[j];
+    normalSin[j] = normalSinScale * sinTable[j];
+  }
+}
+
+#if defined(TOYBOX_SIMD_X86)
+TOYBOX_TARGET_SSE void
+ComputeRingSSE(const float *cosTable, const float *sinTable, size_t count,
+               float cosScale, float sinScale, float normalCosScale,
+               float normalSinScale, float *outCos, float *outSin,
+               float *normalCos, float *normalSin) {
+  const bool withNormal = normalCos != nullptr && normalSin != nullptr;
+  const __m128 vCosScale = _mm_set1_ps(cosScale);
+  const __m128 vSinScale = _mm_set1_ps(sinScale);
+  const __m128 vNormalCosScale = _mm_set1_ps(normalCosScale);
+  const __m128 vNormalSinScale = _mm_set1_ps(normalSinScale);
+
+  size_t j = 0;
+  for (; j + 4 <= count; j += 4) {
+    __m128 c = _mm_loadu_ps(cosTable + j);
+    __m128 s = _mm_loadu_ps(sinTable + j);
+    _mm_storeu_ps(outCos + j, _mm_mul_ps(vCosScale, c));
+    _mm_storeu_ps(outSin + j, _mm_mul_ps(vSinScale, s));
+    if (withNormal) {
+      _mm_storeu_ps(normalCos + j, _mm_mul_ps(vNormalCosScale, c));
+      _mm_storeu_ps(normalSin + j, _mm_mul_ps(vNormalSinScale, s));
+    }
+  }
+  ComputeRingScalar(cosTable, sinTable, j, count, cosScale, sinScale,
+                    normalCosScale, normalSinScale, outCos, outSin, normalCos,
+                    normalSin);
+}
+
+TOYBOX_TARGET_AVX2 void
+ComputeRingAVX2(const float *cosTable, const float *sinTable, size_t count,
+                float cosScale, float sinScale, float normalCosScale,
+                float normalSinScale, float *outCos, float *outSin,
+                float *normalCos, float *normalSin) {
+  const bool withNormal = normalCos != nullptr && normalSin != nullptr;
+  const __m256 vCosScale = _mm256_set1_ps(cosScale);
+  const __m256 vSinScale = _mm256_set1_ps(sinScale);
+  const __m256 vNormalCosScale = _mm256_set1_ps(normalCosScale);
+  const __m256 vNormalSinScale = _mm256_set1_ps(normalSinScale);
+
+  size_t j = 0;
+  for (; j + 8 <= count; j += 8) {
+    __m256 c = _mm256_loadu_ps(cosTable + j);
+    __m256 s = _mm256_loadu_ps(sinTable + j);
+    _mm256_storeu_ps(outCos + j, _mm256_mul_ps(vCosScale, c));
+    _mm256_storeu_ps(outSin + j, _mm256_mul_ps(vSinScale, s));
+    if (withNormal) {
+      _mm256_storeu_ps(normalCos + j, _mm256_mul_ps(vNormalCosScale, c));
+      _mm256_storeu_ps(normalSin + j, _mm256_mul_ps(vNormalSinScale, s));
+    }
+  }
+  ComputeRingScalar(cosTable, sinTable, j, count, cosScale, sinScale,
+                    normalCosScale, normalSinScale, outCos, outSin, normalCos,
+                    normalSin);
+}
+#endif
+} // namespace
+
+RingTable::RingTable(float unitAngle, size_t count)
+    : cosTable(count), sinTable(count) {
+  for (size_t j = 0; j < count; ++j) {
+    cosTable[j] = cos(unitAngle * float(j));
+    sinTable[j] = sin(unitAngle * float(j));
+  }
+}
+
+void Toybox::ComputeRing(const float *cosTable, const float *sinTable,
+                         size_t count, float cosScale, float sinScale,
+                         float normalCosScale, float normalSinScale,
+                         float *outCos, float *outSin, float *normalCos,
+                         float *normalSin) {
+  ComputeRing(DetectSimdLevel(), cosTable, sinTable, count, cosScale,
+              sinScale, normalCosScale, normalSinScale, outCos, outSin,
+              normalCos, normalSin);
+}
+
+void Toybox::ComputeRing(SimdLevelEnum level, const float *cosTable,
+                         const float *sinTable, size_t count, float cosScale,
+                         float sinScale, float normalCosScale,
+                         float normalSinScale, float *outCos, float *outSin,
+                         float *normalCos, float *normalSin) {
+  switch (level) {
+#if defined(TOYBOX_SIMD_X86)
+  case SIMD_AVX2:
+    ComputeRingAVX2(cosTable, sinTable, count, cosScale, sinScale,
+                    normalCosScale, normalSinScale, outCos, outSin, normalCos,
+                    normalSin);
+    return;
+  case SIMD_SSE:
+    ComputeRingSSE(cosTable, sinTable, count, cosScale, sinScale,
+                   normalCosScale, normalSinScale, outCos, outSin, normalCos,
+                   normalSin);
+    return;
+#endif
+  default:
+    ComputeRingScalar(cosTable, sinTable, 0, count, cosScale, sinScale,
+                      normalCosScale, normalSinScale, outCos, outSin,
+                      normalCos, normalSin);
+    return;
+  }
+}
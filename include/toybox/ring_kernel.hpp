@@ -0,0 +1,42 @@
+#ifndef TOYBOX_RING_KERNEL_H
+#define TOYBOX_RING_KERNEL_H
+
+#include <cstddef>
+#include <toybox/mesh_soa.hpp>
+#include <toybox/simd.hpp>
+
+namespace Toybox {
+
+//! 원 둘레를 count 등분한 각도의 cos/sin table.
+//! angle[j] = unitAngle * j 이며, slice마다 한 번만 계산해 모든 ring이 공유한다.
+class RingTable {
+public:
+  RingTable(float unitAngle, size_t count);
+
+  size_t size() const { return cosTable.size(); }
+  const float *Cos() const { return cosTable.data(); }
+  const float *Sin() const { return sinTable.data(); }
+
+private:
+  AlignedVector<float> cosTable;
+  AlignedVector<float> sinTable;
+};
+
+//! ring 한 개의 두 평면 성분을 계산한다.
+//! - outCos[j] = cosScale * cosTable[j], outSin[j] = sinScale * sinTable[j]
+//! - normalCos/normalSin이 nullptr이 아니면 법선도 같은 방식으로 계산한다.
+//! 감지된 SIMD 수준(AVX2 8개, SSE 4개 단위)으로 실행된다.
+void ComputeRing(const float *cosTable, const float *sinTable, size_t count,
+                 float cosScale, float sinScale, float normalCosScale,
+                 float normalSinScale, float *outCos, float *outSin,
+                 float *normalCos, float *normalSin);
+
+//! SIMD 수준을 직접 지정해 실행한다. CPU가 지원하지 않는 수준은 지정하면 안 된다.
+void ComputeRing(SimdLevelEnum level, const float *cosTable,
+                 const float *sinTable, size_t count, float cosScale,
+                 float sinScale, float normalCosScale, float normalSinScale,
+                 float *outCos, float *outSin, float *normalCos,
+                 float *normalSin);
+} // namespace Toybox
+
+#endif
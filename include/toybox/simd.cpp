@@ -0,0 +1,49 @@
+#include "toybox/simd.hpp"
+
+#if defined(TOYBOX_SIMD_X86) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#elif defined(TOYBOX_SIMD_X86)
+#include <cpuid.h>
+#endif
+
+using namespace Toybox;
+
+namespace {
+#if defined(TOYBOX_SIMD_X86)
+bool CpuSupportsAVX2() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  //=> OS가 AVX 상태를 저장하는지(OSXSAVE) 확인한다.
+  if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+    return false;
+  if ((info[2] & (1 << 29)) == 0) // F16C
+    return false;
+  if ((_xgetbv(0) & 0x6) != 0x6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_F16C) == 0)
+    return false;
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+} // namespace
+
+SimdLevelEnum Toybox::DetectSimdLevel() {
+#if defined(TOYBOX_SIMD_X86)
+  static const SimdLevelEnum level =
+      CpuSupportsAVX2() ? SIMD_AVX2 : SIMD_SSE;
+  return level;
+#else
+  return SIMD_SCALAR;
+#endif
+}
@@ -0,0 +1,27 @@
+#ifndef TOYBOX_SIMD_H
+#define TOYBOX_SIMD_H
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#define TOYBOX_SIMD_X86 1
+#endif
+
+//=> GCC/Clang은 함수 단위로 명령어 집합을 지정해야 intrinsic을 사용할 수 있다.
+#if defined(TOYBOX_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TOYBOX_TARGET_SSE __attribute__((target("sse2")))
+#define TOYBOX_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#else
+#define TOYBOX_TARGET_SSE
+#define TOYBOX_TARGET_AVX2
+#endif
+
+namespace Toybox {
+
+//! 사용할 SIMD 명령어 수준. SIMD_AVX2는 F16C(half float 변환)를 포함한다.
+enum SimdLevelEnum { SIMD_SCALAR, SIMD_SSE, SIMD_AVX2 };
+
+//! 현재 CPU에서 사용 가능한 가장 높은 SIMD 수준을 조회한다. (최초 1회 검사)
+SimdLevelEnum DetectSimdLevel();
+} // namespace Toybox
+
+#endif
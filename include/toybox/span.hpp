@@ -0,0 +1,49 @@
+#ifndef TOYBOX_SPAN_H
+#define TOYBOX_SPAN_H
+
+#include <cstddef>
+#include <vector>
+
+namespace Toybox {
+
+//! 연속된 메모리 영역을 소유하지 않고 가리키는 view
+template <typename T> class Span {
+public:
+  Span() : ptr(nullptr), length(0) {}
+  Span(T *data, size_t size) : ptr(data), length(size) {}
+
+  template <typename U, typename Alloc>
+  Span(std::vector<U, Alloc> &vec) : ptr(vec.data()), length(vec.size()) {}
+
+  template <typename U, typename Alloc>
+  Span(const std::vector<U, Alloc> &vec)
+      : ptr(vec.data()), length(vec.size()) {}
+
+  T *data() const { return ptr; }
+  size_t size() const { return length; }
+  bool empty() const { return length == 0; }
+
+  T &operator[](size_t i) const { return ptr[i]; }
+  T *begin() const { return ptr; }
+  T *end() const { return ptr + length; }
+
+  Span subspan(size_t offset, size_t count) const {
+    return Span(ptr + offset, count);
+  }
+
+private:
+  T *ptr;
+  size_t length;
+};
+
+template <typename T> Span<T> MakeSpan(T *data, size_t size) {
+  return Span<T>(data, size);
+}
+
+template <typename T, typename Alloc>
+Span<T> MakeSpan(std::vector<T, Alloc> &vec) {
+  return Span<T>(vec);
+}
+} // namespace Toybox
+
+#endif
@@ -0,0 +1,687 @@
+#include "toybox/primitives.hpp"
+#include "toybox/profiler.hpp"
+#include "toybox/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+using namespace Toybox;
+
+namespace {
+constexpr uint64_t kEmptyKey = UINT64_MAX;
+constexpr uint32_t kNoEdge = UINT32_MAX;
+constexpr uint32_t kNoVertex = UINT32_MAX;
+
+//! out[i] = countAt(0) + ... + countAt(i - 1)를 [0, count] 범위에 쓴다.
+//! chunk별 합을 병렬로 구하고 chunk 순서로 누적한 뒤, chunk마다 다시 채운다.
+//! 합계는 uint32_t 범위여야 한다.
+template <typename CountFn>
+void ExclusiveScan(ThreadPool *pool, size_t count, CountFn countAt,
+                   std::vector<uint32_t> &out) {
+  out.resize(count + 1);
+  const size_t chunkCount = (count + kParallelGrain - 1) / kParallelGrain;
+  std::vector<uint32_t> chunkBase(chunkCount + 1, 0);
+  ParallelFor(pool, chunkCount, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+    for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+      size_t end = std::min(count, (chunk + 1) * kParallelGrain);
+      for (size_t i = chunk * kParallelGrain; i < end; ++i)
+        chunkBase[chunk + 1] += countAt(i);
+    }
+  });
+  for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+    chunkBase[chunk + 1] += chunkBase[chunk];
+
+  ParallelFor(pool, chunkCount, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+    for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+      uint32_t sum = chunkBase[chunk];
+      size_t end = std::min(count, (chunk + 1) * kParallelGrain);
+      for (size_t i = chunk * kParallelGrain; i < end; ++i) {
+        out[i] = sum;
+        sum += countAt(i);
+      }
+    }
+  });
+  out[count] = chunkBase[chunkCount];
+}
+
+uint64_t EdgeKey(uint32_t a, uint32_t b) {
+  return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+}
+
+//! edge key -> slot의 open addressing hash table
+//! 여러 thread가 동시에 삽입할 수 있다. slot마다 그 edge를 사용한 가장 작은
+//! corner 번호(owner)를 기억해, 삽입 순서와 관계없이 같은 edge 번호를 매긴다.
+//! Payload는 edge별 추가 정보이며 key와 같은 cache line에 놓인다.
+//!
+//! 작은 쪽 vertex마다 그 vertex를 작은 끝으로 갖는 corner 수만큼 연속된
+//! bucket을 미리 잡는다. (Count -> Allocate -> Insert 순서로 사용)
+//! 탐색은 bucket 안에서 끝나므로 넘치지 않고, Mesh의 vertex 번호가 공간적으로
+//! 모여 있어 삼각형 순서대로 삽입하면 가까운 slot만 접근한다.
+template <typename Payload> class EdgeTable {
+public:
+  struct Slot {
+    std::atomic<uint64_t> key;
+    std::atomic<uint32_t> owner;
+    uint32_t id; // NumberEdges가 매기는 edge 번호
+    Payload payload;
+  };
+
+  //! edge의 vertex 번호는 [0, vertexIdCount) 범위이다.
+  EdgeTable(size_t vertexIdCount, ThreadPool *pool)
+      : vertexIdCount(vertexIdCount),
+        counts(new std::atomic<uint32_t>[vertexIdCount]) {
+    ParallelFor(pool, vertexIdCount, kParallelGrain * 4,
+                [this](size_t begin, size_t end) {
+                  for (size_t v = begin; v < end; ++v)
+                    counts[v].store(0, std::memory_order_relaxed);
+                });
+  }
+
+  //! 삽입될 edge 하나(corner 하나)를 미리 센다.
+  void Count(uint64_t key) {
+    counts[key >> 32].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  //! 센 개수로 bucket 위치를 정하고 slot을 비운다.
+  void Allocate(ThreadPool *pool) {
+    ExclusiveScan(
+        pool, vertexIdCount,
+        [this](size_t v) { return counts[v].load(std::memory_order_relaxed); },
+        bucketStarts);
+    const size_t capacity = bucketStarts[vertexIdCount];
+    counts.reset();
+
+    slots.reset(new Slot[std::max<size_t>(capacity, 1)]);
+    ParallelFor(pool, capacity, kParallelGrain * 4, [this](size_t begin,
+                                                           size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        slots[i].key.store(kEmptyKey, std::memory_order_relaxed);
+        slots[i].owner.store(UINT32_MAX, std::memory_order_relaxed);
+        slots[i].payload.Reset();
+      }
+    });
+  }
+
+  Slot &operator[](uint32_t slot) { return slots[slot]; }
+  const Slot &operator[](uint32_t slot) const { return slots[slot]; }
+
+  //! key의 slot을 찾거나 만들고, owner를 corner와 비교해 작은 값으로 둔다.
+  //! key는 Count로 센 것이어야 한다.
+  uint32_t Insert(uint64_t key, uint32_t corner) {
+    uint32_t index = bucketStarts[key >> 32];
+    while (true) {
+      uint64_t current = slots[index].key.load(std::memory_order_relaxed);
+      if (current == kEmptyKey &&
+          slots[index].key.compare_exchange_strong(current, key,
+                                                   std::memory_order_relaxed))
+        break;
+      if (current == key)
+        break;
+      ++index;
+    }
+
+    std::atomic<uint32_t> &owner = slots[index].owner;
+    uint32_t current = owner.load(std::memory_order_relaxed);
+    while (corner < current &&
+           !owner.compare_exchange_weak(current, corner,
+                                        std::memory_order_relaxed)) {
+    }
+    return index;
+  }
+
+private:
+  size_t vertexIdCount;
+  std::unique_ptr<std::atomic<uint32_t>[]> counts;
+  std::vector<uint32_t> bucketStarts;
+  std::unique_ptr<Slot[]> slots;
+};
+
+//! corner 순서로 edge 번호를 매긴다. corner가 slot의 owner일 때만 새 번호를
+//! 받으므로 Mesh의 index 순서대로 번호가 정해진다.
+//! table[slot].id = edge 번호, 반환값[edge 번호] = slot
+template <typename Payload>
+std::vector<uint32_t> NumberEdges(EdgeTable<Payload> &table,
+                                  const std::vector<uint32_t> &cornerSlots,
+                                  ThreadPool *pool) {
+  const size_t cornerCount = cornerSlots.size();
+  const size_t chunkCount = (cornerCount + kParallelGrain - 1) / kParallelGrain;
+  auto isOwner = [&](size_t corner) {
+    uint32_t slot = cornerSlots[corner];
+    return slot != kNoEdge &&
+           table[slot].owner.load(std::memory_order_relaxed) == corner;
+  };
+
+  std::vector<size_t> chunkBase(chunkCount + 1, 0);
+  ParallelFor(pool, chunkCount, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+    for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+      size_t end = std::min(cornerCount, (chunk + 1) * kParallelGrain);
+      for (size_t corner = chunk * kParallelGrain; corner < end; ++corner)
+        chunkBase[chunk + 1] += isOwner(corner);
+    }
+  });
+  for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+    chunkBase[chunk + 1] += chunkBase[chunk];
+
+  std::vector<uint32_t> edgeSlots(chunkBase[chunkCount]);
+  ParallelFor(pool, chunkCount, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+    for (size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk) {
+      uint32_t id = uint32_t(chunkBase[chunk]);
+      size_t end = std::min(cornerCount, (chunk + 1) * kParallelGrain);
+      for (size_t corner = chunk * kParallelGrain; corner < end; ++corner) {
+        if (!isOwner(corner))
+          continue;
+        table[cornerSlots[corner]].id = id;
+        edgeSlots[id++] = cornerSlots[corner];
+      }
+    }
+  });
+  return edgeSlots;
+}
+
+struct NoPayload {
+  void Reset() {}
+};
+
+//! 위치 위상 edge의 인접 정보
+struct TopologyEdge {
+  std::atomic<uint32_t> useCount; // 면이 있는 인접 삼각형 수
+  uint32_t opposites[2];          // 처음 두 삼각형의 맞은편 위상 vertex
+  uint64_t sideKeys[2];           // 처음 두 삼각형의 normal 위상 쌍
+
+  //! 면이 있는 삼각형이 하나도 없는 edge도 값이 정해지도록 모두 비운다.
+  void Reset() {
+    useCount.store(0, std::memory_order_relaxed);
+    opposites[0] = opposites[1] = 0;
+    sideKeys[0] = sideKeys[1] = 0;
+  }
+};
+
+//! Mesh와 위상(topology) 정보
+//! - 위치 위상: position이 같은 vertex(wedge)는 하나의 위상 vertex를 공유하며,
+//!   새 위치는 위상 vertex 기준으로 계산한다. (texture seam이 갈라지지 않음)
+//! - normal 위상: position과 normal이 모두 같은 wedge를 묶는다. edge 양쪽
+//!   삼각형의 normal 위상이 다르면 그 edge는 crease(각진 모서리)이다.
+struct SubdivisionLevel {
+  Mesh mesh; // 첫 단계에서는 비어 있고 입력 Mesh를 따로 넘긴다.
+  std::vector<uint32_t> topology;       // wedge -> 위치 위상 vertex 번호
+  std::vector<uint32_t> normalTopology; // wedge -> normal 위상 번호
+  std::vector<float> topologyPositions; // 위치 위상 vertex마다 3개
+};
+
+//! weld에 사용하는 vertex 값. position 3개 뒤에 normal 3개가 온다.
+//! -0.0과 0.0을 같은 값으로 본다.
+void WeldWords(const Vertex &v, uint32_t (&words)[6]) {
+  const float values[6] = {v.x + 0.0f,  v.y + 0.0f,  v.z + 0.0f,
+                           v.nx + 0.0f, v.ny + 0.0f, v.nz + 0.0f};
+  std::memcpy(words, values, sizeof(values));
+}
+
+//! WeldWords의 앞 WordCount개가 bit 단위로 같은 vertex를 묶는 open
+//! addressing hash table. 여러 thread가 동시에 삽입할 수 있으며, slot에는
+//! 같은 값을 가진 vertex 중 가장 작은 번호(대표)가 남는다. 따라서 삽입
+//! 순서와 관계없이 같은 대표를 얻는다. (Insert를 모두 끝낸 뒤 Find를 사용)
+template <int WordCount> class WeldTable {
+public:
+  WeldTable(const std::vector<Vertex> &vertexes, ThreadPool *pool)
+      : vertexes(vertexes) {
+    size_t capacity = 16;
+    while (capacity < vertexes.size() * 2)
+      capacity *= 2;
+    mask = capacity - 1;
+    slots.reset(new std::atomic<uint32_t>[capacity]);
+    ParallelFor(pool, capacity, kParallelGrain * 4,
+                [this](size_t begin, size_t end) {
+                  for (size_t i = begin; i < end; ++i)
+                    slots[i].store(kNoVertex, std::memory_order_relaxed);
+                });
+  }
+
+  void Insert(uint32_t vertex) {
+    uint32_t words[6];
+    WeldWords(vertexes[vertex], words);
+    for (size_t index = Hash(words);; index = (index + 1) & mask) {
+      std::atomic<uint32_t> &slot = slots[index];
+      uint32_t current = slot.load(std::memory_order_relaxed);
+      if (current == kNoVertex &&
+          slot.compare_exchange_strong(current, vertex,
+                                       std::memory_order_relaxed))
+        return;
+      //=> 빈 slot을 다른 thread가 먼저 채웠으면 current는 그 vertex이다.
+      if (!Equal(current, words))
+        continue;
+      while (vertex < current &&
+             !slot.compare_exchange_weak(current, vertex,
+                                         std::memory_order_relaxed)) {
+      }
+      return;
+    }
+  }
+
+  //! vertex와 같은 값을 가진 vertex 중 가장 작은 번호
+  uint32_t Find(uint32_t vertex) const {
+    uint32_t words[6];
+    WeldWords(vertexes[vertex], words);
+    for (size_t index = Hash(words);; index = (index + 1) & mask) {
+      uint32_t current = slots[index].load(std::memory_order_relaxed);
+      if (Equal(current, words))
+        return current;
+    }
+  }
+
+private:
+  size_t Hash(const uint32_t *words) const {
+    uint64_t h = 0;
+    for (int i = 0; i < WordCount; ++i)
+      h = (h ^ words[i]) * 0x100000001B3ull;
+    return size_t(h ^ (h >> 29)) & mask;
+  }
+
+  bool Equal(uint32_t vertex, const uint32_t *words) const {
+    uint32_t other[6];
+    WeldWords(vertexes[vertex], other);
+    return std::memcmp(other, words, sizeof(uint32_t) * WordCount) == 0;
+  }
+
+  const std::vector<Vertex> &vertexes;
+  size_t mask;
+  std::unique_ptr<std::atomic<uint32_t>[]> slots;
+};
+
+//! Mesh의 위상 정보를 만든다. mesh 자체는 복사하지 않는다.
+//! 위상 번호는 대표 vertex가 처음 나온 순서대로 매기므로 thread 수와
+//! 관계없이 같다.
+SubdivisionLevel MakeFirstLevel(const Mesh &mesh, ThreadPool *pool) {
+  const size_t vertexCount = mesh.vertexes.size();
+  if (vertexCount >= size_t(kNoVertex))
+    throw std::runtime_error("subdivision 결과가 uint32_t index 범위를 "
+                             "넘습니다.");
+  WeldTable<3> positionTable(mesh.vertexes, pool);
+  WeldTable<6> normalTable(mesh.vertexes, pool);
+  ParallelFor(pool, vertexCount, kParallelGrain, [&](size_t begin,
+                                                     size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      positionTable.Insert(uint32_t(i));
+      normalTable.Insert(uint32_t(i));
+    }
+  });
+
+  std::vector<uint32_t> positionFirst(vertexCount);
+  std::vector<uint32_t> normalFirst(vertexCount);
+  ParallelFor(pool, vertexCount, kParallelGrain, [&](size_t begin,
+                                                     size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      positionFirst[i] = positionTable.Find(uint32_t(i));
+      normalFirst[i] = normalTable.Find(uint32_t(i));
+    }
+  });
+
+  std::vector<uint32_t> positionIds;
+  std::vector<uint32_t> normalIds;
+  ExclusiveScan(
+      pool, vertexCount,
+      [&](size_t i) { return uint32_t(positionFirst[i] == i); }, positionIds);
+  ExclusiveScan(
+      pool, vertexCount,
+      [&](size_t i) { return uint32_t(normalFirst[i] == i); }, normalIds);
+
+  SubdivisionLevel level;
+  level.topology.resize(vertexCount);
+  level.normalTopology.resize(vertexCount);
+  level.topologyPositions.resize(size_t(positionIds[vertexCount]) * 3);
+  ParallelFor(pool, vertexCount, kParallelGrain, [&](size_t begin,
+                                                     size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      level.topology[i] = positionIds[positionFirst[i]];
+      level.normalTopology[i] = normalIds[normalFirst[i]];
+      if (positionFirst[i] != i)
+        continue;
+      const Vertex &v = mesh.vertexes[i];
+      float *p = &level.topologyPositions[size_t(positionIds[i]) * 3];
+      p[0] = v.x, p[1] = v.y, p[2] = v.z;
+    }
+  });
+  return level;
+}
+
+//! Loop subdivision 한 단계
+//! mesh는 in의 위상 정보에 해당하는 Mesh이다.
+SubdivisionLevel SubdivideLevel(const Mesh &mesh, const SubdivisionLevel &in,
+                                ThreadPool *pool) {
+  const std::vector<Vertex> &vertexes = mesh.vertexes;
+  const std::vector<uint32_t> &indexes = mesh.indexes;
+  const std::vector<uint32_t> &topology = in.topology;
+  const std::vector<uint32_t> &normalTopology = in.normalTopology;
+  const float *positions = in.topologyPositions.data();
+  const size_t vertexCount = vertexes.size();
+  const size_t triangleCount = indexes.size() / 3;
+  const size_t cornerCount = triangleCount * 3;
+  const size_t topologyCount = in.topologyPositions.size() / 3;
+  if (cornerCount > size_t(UINT32_MAX) ||
+      vertexCount + cornerCount > size_t(UINT32_MAX))
+    throw std::runtime_error("subdivision 결과가 uint32_t index 범위를 "
+                             "넘습니다.");
+
+  //! edge 한쪽 삼각형의 normal 위상 쌍. 위치 위상 번호가 작은 쪽이 앞이다.
+  auto sideKey = [&](uint32_t a, uint32_t b) {
+    if (topology[b] < topology[a])
+      std::swap(a, b);
+    return (uint64_t(normalTopology[a]) << 32) | normalTopology[b];
+  };
+
+  //> 1. edge 수집
+  //=> wedge edge마다 새 vertex가 하나 생기고, 위치 위상 edge는 새 위치
+  //=> 계산에 쓴다. 위상 edge는 인접 삼각형 수와, 각 삼각형의 맞은편 vertex와
+  //=> normal 위상 쌍을 두 개까지 기록한다.
+  //=> 먼저 edge의 작은 쪽 vertex별로 corner 수를 세어 bucket을 잡는다.
+  EdgeTable<NoPayload> wedgeEdges(vertexCount, pool);
+  EdgeTable<TopologyEdge> topologyEdges(topologyCount, pool);
+  ParallelFor(pool, triangleCount, kParallelGrain, [&](size_t begin,
+                                                       size_t end) {
+    for (size_t t = begin; t < end; ++t) {
+      const uint32_t *tri = &indexes[t * 3];
+      const uint32_t topo[3] = {topology.at(tri[0]), topology.at(tri[1]),
+                                topology.at(tri[2])};
+      for (int k = 0; k < 3; ++k) {
+        int next = (k + 1) % 3;
+        wedgeEdges.Count(EdgeKey(tri[k], tri[next]));
+        if (topo[k] != topo[next])
+          topologyEdges.Count(EdgeKey(topo[k], topo[next]));
+      }
+    }
+  });
+  wedgeEdges.Allocate(pool);
+  topologyEdges.Allocate(pool);
+
+  std::vector<uint32_t> cornerWedgeEdge(cornerCount);
+  std::vector<uint32_t> cornerTopologyEdge(cornerCount);
+  ParallelFor(pool, triangleCount, kParallelGrain, [&](size_t begin,
+                                                       size_t end) {
+    for (size_t t = begin; t < end; ++t) {
+      const uint32_t *tri = &indexes[t * 3];
+      const uint32_t topo[3] = {topology[tri[0]], topology[tri[1]],
+                                topology[tri[2]]};
+      //=> 위상 vertex가 겹친 삼각형(구의 극점 등)은 면이 없으므로 인접
+      //=> 정보에 넣지 않는다.
+      bool degenerate =
+          topo[0] == topo[1] || topo[1] == topo[2] || topo[2] == topo[0];
+      for (int k = 0; k < 3; ++k) {
+        uint32_t corner = uint32_t(t * 3 + k);
+        int next = (k + 1) % 3;
+        cornerWedgeEdge[corner] =
+            wedgeEdges.Insert(EdgeKey(tri[k], tri[next]), corner);
+        if (topo[k] == topo[next]) {
+          cornerTopologyEdge[corner] = kNoEdge;
+          continue;
+        }
+        uint32_t slot =
+            topologyEdges.Insert(EdgeKey(topo[k], topo[next]), corner);
+        cornerTopologyEdge[corner] = slot;
+        if (degenerate)
+          continue;
+        TopologyEdge &edge = topologyEdges[slot].payload;
+        uint32_t use = edge.useCount.fetch_add(1, std::memory_order_relaxed);
+        if (use < 2) {
+          edge.opposites[use] = topo[(k + 2) % 3];
+          edge.sideKeys[use] = sideKey(tri[k], tri[next]);
+        }
+      }
+    }
+  });
+
+  const std::vector<uint32_t> wedgeEdgeSlots =
+      NumberEdges(wedgeEdges, cornerWedgeEdge, pool);
+  const std::vector<uint32_t> topologyEdgeSlots =
+      NumberEdges(topologyEdges, cornerTopologyEdge, pool);
+  const size_t wedgeEdgeCount = wedgeEdgeSlots.size();
+  const size_t topologyEdgeCount = topologyEdgeSlots.size();
+
+  //=> 삼각형 두 개가 같은 normal로 공유하는 edge만 매끄럽게 만든다. 열린
+  //=> 경계, non-manifold edge, normal이 갈라지는 edge는 crease이다.
+  auto isSmooth = [](const TopologyEdge &edge) {
+    return edge.useCount.load(std::memory_order_relaxed) == 2 &&
+           edge.sideKeys[0] == edge.sideKeys[1];
+  };
+
+  SubdivisionLevel out;
+  out.topologyPositions.resize((topologyCount + topologyEdgeCount) * 3);
+  float *outPositions = out.topologyPositions.data();
+
+  //> 2. 기존 위상 vertex의 새 위치
+  //=> 면이 있는 edge의 두 끝과 crease 여부를 모으고, 위상 vertex -> edge
+  //=> 번호 CSR을 만든다. 그 뒤 vertex마다 자기 edge만 읽어 병렬로 모은다.
+  constexpr uint32_t kCreaseBit = 0x80000000u;
+  constexpr uint32_t kNoFace = UINT32_MAX;
+  std::vector<uint32_t> edgeEnds(topologyEdgeCount * 2);
+  std::unique_ptr<std::atomic<uint32_t>[]> edgeCursors(
+      new std::atomic<uint32_t>[topologyCount]);
+  ParallelFor(pool, topologyCount, kParallelGrain * 4,
+              [&](size_t begin, size_t end) {
+                for (size_t v = begin; v < end; ++v)
+                  edgeCursors[v].store(0, std::memory_order_relaxed);
+              });
+  ParallelFor(pool, topologyEdgeCount, kParallelGrain, [&](size_t begin,
+                                                           size_t end) {
+    for (size_t id = begin; id < end; ++id) {
+      const auto &slot = topologyEdges[topologyEdgeSlots[id]];
+      if (slot.payload.useCount.load(std::memory_order_relaxed) == 0) {
+        edgeEnds[id * 2] = kNoFace;
+        continue;
+      }
+      uint64_t key = slot.key.load(std::memory_order_relaxed);
+      edgeEnds[id * 2] = uint32_t(key >> 32);
+      edgeEnds[id * 2 + 1] =
+          uint32_t(key) | (isSmooth(slot.payload) ? 0 : kCreaseBit);
+      edgeCursors[key >> 32].fetch_add(1, std::memory_order_relaxed);
+      edgeCursors[uint32_t(key)].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  std::vector<uint32_t> edgeOffsets;
+  ExclusiveScan(
+      pool, topologyCount,
+      [&](size_t v) { return edgeCursors[v].load(std::memory_order_relaxed); },
+      edgeOffsets);
+  ParallelFor(pool, topologyCount, kParallelGrain * 4,
+              [&](size_t begin, size_t end) {
+                for (size_t v = begin; v < end; ++v)
+                  edgeCursors[v].store(edgeOffsets[v],
+                                       std::memory_order_relaxed);
+              });
+  std::vector<uint32_t> vertexEdges(edgeOffsets[topologyCount]);
+  ParallelFor(pool, topologyEdgeCount, kParallelGrain, [&](size_t begin,
+                                                           size_t end) {
+    for (size_t id = begin; id < end; ++id) {
+      if (edgeEnds[id * 2] == kNoFace)
+        continue;
+      for (uint32_t v : {edgeEnds[id * 2], edgeEnds[id * 2 + 1] & ~kCreaseBit})
+        vertexEdges[edgeCursors[v].fetch_add(1, std::memory_order_relaxed)] =
+            uint32_t(id);
+    }
+  });
+  edgeCursors.reset();
+
+  ParallelFor(pool, topologyCount, kParallelGrain, [&](size_t begin,
+                                                       size_t end) {
+    for (size_t v = begin; v < end; ++v) {
+      //=> 채운 순서는 thread마다 다르므로 edge 번호 순서로 정렬해 더한다.
+      //=> 나누는 방법과 관계없이 같은 값을 얻는다.
+      uint32_t *edges = vertexEdges.data() + edgeOffsets[v];
+      uint32_t n = edgeOffsets[v + 1] - edgeOffsets[v];
+      std::sort(edges, edges + n);
+
+      uint32_t creaseCount = 0;
+      float neighborSum[3] = {0.0f, 0.0f, 0.0f};
+      float creaseSum[3] = {0.0f, 0.0f, 0.0f};
+      for (uint32_t e = 0; e < n; ++e) {
+        uint32_t id = edges[e];
+        uint32_t end0 = edgeEnds[id * 2];
+        uint32_t end1 = edgeEnds[id * 2 + 1] & ~kCreaseBit;
+        const float *q = positions + size_t(end0 == v ? end1 : end0) * 3;
+        for (int a = 0; a < 3; ++a)
+          neighborSum[a] += q[a];
+        if (edgeEnds[id * 2 + 1] & kCreaseBit) {
+          ++creaseCount;
+          for (int a = 0; a < 3; ++a)
+            creaseSum[a] += q[a];
+        }
+      }
+
+      const float *p = positions + v * 3;
+      float *result = outPositions + v * 3;
+      if (creaseCount == 2) {
+        //=> crease 위의 vertex: crease 방향 이웃 두 개만 사용한다.
+        for (int a = 0; a < 3; ++a)
+          result[a] = 0.75f * p[a] + 0.125f * creaseSum[a];
+      } else if (creaseCount > 2 || n < 3) {
+        //=> crease가 만나는 꼭짓점(cube의 모서리)은 움직이지 않는다.
+        std::copy(p, p + 3, result);
+      } else {
+        float beta = n == 3 ? 3.0f / 16.0f : 3.0f / (8.0f * n);
+        for (int a = 0; a < 3; ++a)
+          result[a] = (1.0f - n * beta) * p[a] + beta * neighborSum[a];
+      }
+    }
+  });
+
+  //> 3. edge 위 새 위상 vertex의 위치
+  ParallelFor(pool, topologyEdgeCount, kParallelGrain, [&](size_t begin,
+                                                           size_t end) {
+    for (size_t id = begin; id < end; ++id) {
+      const auto &slot = topologyEdges[topologyEdgeSlots[id]];
+      uint64_t key = slot.key.load(std::memory_order_relaxed);
+      const float *p0 = positions + size_t(key >> 32) * 3;
+      const float *p1 = positions + size_t(uint32_t(key)) * 3;
+      float *result = outPositions + (topologyCount + id) * 3;
+      if (isSmooth(slot.payload)) {
+        const float *q0 = positions + size_t(slot.payload.opposites[0]) * 3;
+        const float *q1 = positions + size_t(slot.payload.opposites[1]) * 3;
+        for (int a = 0; a < 3; ++a)
+          result[a] = 0.375f * (p0[a] + p1[a]) + 0.125f * (q0[a] + q1[a]);
+      } else {
+        for (int a = 0; a < 3; ++a)
+          result[a] = 0.5f * (p0[a] + p1[a]);
+      }
+    }
+  });
+
+  //> 4. vertex: 기존 wedge 뒤에 edge wedge를 붙인다.
+  //=> edge wedge의 normal 위상은 (위상 edge, crease의 어느 쪽인지)로 정한다.
+  //=> 번호가 연속일 필요는 없고 같은지만 비교한다.
+  const size_t newVertexCount = vertexCount + wedgeEdgeCount;
+  const uint64_t normalTopologyCount =
+      *std::max_element(normalTopology.begin(), normalTopology.end()) + 1;
+  if (normalTopologyCount + uint64_t(topologyEdgeCount) * 2 >
+      uint64_t(UINT32_MAX))
+    throw std::runtime_error("subdivision 결과가 uint32_t index 범위를 "
+                             "넘습니다.");
+  out.mesh.vertexes.resize(newVertexCount);
+  out.topology.resize(newVertexCount);
+  out.normalTopology.resize(newVertexCount);
+  ParallelFor(pool, vertexCount, kParallelGrain, [&](size_t begin, size_t end) {
+    for (size_t w = begin; w < end; ++w) {
+      Vertex v = vertexes[w];
+      const float *p = outPositions + size_t(topology[w]) * 3;
+      v.x = p[0], v.y = p[1], v.z = p[2];
+      out.mesh.vertexes[w] = v;
+      out.topology[w] = topology[w];
+      out.normalTopology[w] = normalTopology[w];
+    }
+  });
+  ParallelFor(pool, wedgeEdgeCount, kParallelGrain, [&](size_t begin,
+                                                        size_t end) {
+    for (size_t id = begin; id < end; ++id) {
+      const auto &slot = wedgeEdges[wedgeEdgeSlots[id]];
+      uint64_t key = slot.key.load(std::memory_order_relaxed);
+      uint32_t w0 = uint32_t(key >> 32), w1 = uint32_t(key);
+      const Vertex &v0 = vertexes[w0];
+      const Vertex &v1 = vertexes[w1];
+
+      uint32_t topologySlot =
+          cornerTopologyEdge[slot.owner.load(std::memory_order_relaxed)];
+      uint32_t topo, normalTopo;
+      if (topologySlot == kNoEdge) {
+        //=> 두 끝이 같은 위치인 edge는 그 위치에 머문다.
+        topo = topology[w0];
+        normalTopo = std::min(normalTopology[w0], normalTopology[w1]);
+      } else {
+        const auto &edge = topologyEdges[topologySlot];
+        uint32_t edgeId = edge.id;
+        //=> 퇴화 삼각형만 사용한 edge는 side 정보가 없으므로 한쪽으로 둔다.
+        uint32_t side = 0;
+        if (edge.payload.useCount.load(std::memory_order_relaxed) > 0 &&
+            sideKey(w0, w1) != edge.payload.sideKeys[0])
+          side = 1;
+        topo = uint32_t(topologyCount) + edgeId;
+        normalTopo = uint32_t(normalTopologyCount) + edgeId * 2 + side;
+      }
+      const float *p = outPositions + size_t(topo) * 3;
+
+      Vertex v;
+      v.x = p[0], v.y = p[1], v.z = p[2];
+      v.r = 0.5f * (v0.r + v1.r);
+      v.g = 0.5f * (v0.g + v1.g);
+      v.b = 0.5f * (v0.b + v1.b);
+      v.nx = v0.nx + v1.nx;
+      v.ny = v0.ny + v1.ny;
+      v.nz = v0.nz + v1.nz;
+      float length = std::sqrt(v.nx * v.nx + v.ny * v.ny + v.nz * v.nz);
+      if (length > 0.0f) {
+        v.nx /= length, v.ny /= length, v.nz /= length;
+      }
+      v.tx = 0.5f * (v0.tx + v1.tx);
+      v.ty = 0.5f * (v0.ty + v1.ty);
+      out.mesh.vertexes[vertexCount + id] = v;
+      out.topology[vertexCount + id] = topo;
+      out.normalTopology[vertexCount + id] = normalTopo;
+    }
+  });
+
+  //> 5. index: 삼각형 하나를 winding을 유지한 4개로 나눈다.
+  out.mesh.indexes.resize(triangleCount * 12);
+  ParallelFor(pool, triangleCount, kParallelGrain, [&](size_t begin,
+                                                       size_t end) {
+    for (size_t t = begin; t < end; ++t) {
+      const uint32_t *tri = &indexes[t * 3];
+      uint32_t mid[3];
+      for (int k = 0; k < 3; ++k)
+        mid[k] = uint32_t(vertexCount) +
+                 wedgeEdges[cornerWedgeEdge[t * 3 + k]].id;
+      const uint32_t result[12] = {tri[0], mid[0], mid[2], mid[0],
+                                   tri[1], mid[1], mid[2], mid[1],
+                                   tri[2], mid[0], mid[1], mid[2]};
+      std::copy(result, result + 12, &out.mesh.indexes[t * 12]);
+    }
+  });
+  return out;
+}
+
+Mesh Subdivide(const Mesh &primitive, int levelCount, ThreadPool *pool) {
+  TOYBOX_PROFILE_SCOPE(profile, "Primitives::MakeSubdivision");
+  if (levelCount < 0)
+    throw std::runtime_error("subdivision 단계 수는 0 이상이어야 합니다.");
+  if (levelCount == 0 || primitive.vertexes.empty())
+    return primitive;
+
+  SubdivisionLevel level =
+      SubdivideLevel(primitive, MakeFirstLevel(primitive, pool), pool);
+  for (int i = 1; i < levelCount; ++i)
+    level = SubdivideLevel(level.mesh, level, pool);
+  TOYBOX_PROFILE_OUTPUT(profile, level.mesh.vertexes.size(),
+                        level.mesh.indexes.size(),
+                        level.mesh.vertexes.size() * sizeof(Vertex) +
+                            level.mesh.indexes.size() * sizeof(uint32_t));
+  return std::move(level.mesh);
+}
+} // namespace
+
+Mesh Primitives::MakeSubdivision(const Mesh &primitive, int levelCount) {
+  return Subdivide(primitive, levelCount, nullptr);
+}
+
+Mesh Primitives::MakeSubdivision(const Mesh &primitive, int levelCount,
+                                 ThreadPool &pool) {
+  return Subdivide(primitive, levelCount, &pool);
+}
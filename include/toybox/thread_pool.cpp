@@ -0,0 +1,145 @@
+#include "toybox/thread_pool.hpp"
+#include <exception>
+
+using namespace Toybox;
+
+namespace {
+//! 현재 thread가 worker로 속한 pool과 그 worker 번호
+thread_local const ThreadPool *currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+} // namespace
+
+ThreadPool::ThreadPool(size_t workerCount) : pendingCount(0), stopping(false) {
+  if (workerCount == 0)
+    workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+  //=> worker가 시작하기 전에 모든 queue가 있어야 한다.
+  queues.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i)
+    queues.push_back(std::make_unique<WorkerQueue>());
+
+  workers.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i)
+    workers.emplace_back([this, i]() { WorkerLoop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  condition.notify_all();
+  for (auto &worker : workers)
+    worker.join();
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+  WorkerQueue &queue =
+      currentPool == this ? *queues[currentWorker] : sharedQueue;
+
+  //=> 개수를 먼저 올려야 작업을 꺼낸 worker가 0 아래로 내리지 않는다.
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++pendingCount;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  condition.notify_one();
+}
+
+void ThreadPool::Run(const std::vector<std::function<void()>> &tasks) {
+  if (tasks.empty())
+    return;
+
+  //> 작업 목록을 공유하고, 각 thread는 다음 작업 번호를 가져가 실행한다.
+  struct SharedState {
+    std::atomic<size_t> next{0};
+    size_t finished = 0;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+  auto state = std::make_shared<SharedState>();
+  const size_t taskCount = tasks.size();
+
+  auto drain = [state, &tasks, taskCount]() {
+    size_t completed = 0;
+    std::exception_ptr error;
+    for (size_t i = state->next++; i < taskCount; i = state->next++) {
+      try {
+        tasks[i]();
+      } catch (...) {
+        if (!error)
+          error = std::current_exception();
+      }
+      ++completed;
+    }
+    if (completed == 0)
+      return;
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (error && !state->error)
+      state->error = error;
+    state->finished += completed;
+    if (state->finished == taskCount)
+      state->done.notify_all();
+  };
+
+  //=> 호출 thread가 하나를 맡으므로 나머지만큼만 worker를 깨운다.
+  size_t helperCount = std::min(workers.size(), taskCount - 1);
+  for (size_t i = 0; i < helperCount; ++i)
+    Submit(drain);
+  drain();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&]() { return state->finished == taskCount; });
+  if (state->error)
+    std::rethrow_exception(state->error);
+}
+
+bool ThreadPool::TakeTask(size_t workerIndex, std::function<void()> &task) {
+  auto popBack = [&task](WorkerQueue &queue) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+      return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+  };
+  auto popFront = [&task](WorkerQueue &queue) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+      return false;
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+  };
+
+  bool found = popBack(*queues[workerIndex]) || popFront(sharedQueue);
+  //=> 다음 worker부터 차례로 훔쳐 한 queue에 몰리지 않게 한다.
+  for (size_t k = 1; !found && k < queues.size(); ++k)
+    found = popFront(*queues[(workerIndex + k) % queues.size()]);
+  if (found)
+    --pendingCount;
+  return found;
+}
+
+void ThreadPool::WorkerLoop(size_t workerIndex) {
+  currentPool = this;
+  currentWorker = workerIndex;
+
+  while (true) {
+    std::function<void()> task;
+    if (TakeTask(workerIndex, task)) {
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this]() { return stopping || pendingCount > 0; });
+    if (stopping && pendingCount == 0)
+      return;
+  }
+}
@@ -0,0 +1,94 @@
+#ifndef TOYBOX_THREAD_POOL_H
+#define TOYBOX_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Toybox {
+
+//! 고정된 개수의 worker thread로 작업을 실행하는 work-stealing thread pool
+//! worker마다 자신의 queue를 가진다. worker 안에서 추가한 작업은 그 worker의
+//! queue 뒤에 들어가 먼저 실행되고(LIFO), 일이 없는 worker는 다른 worker
+//! queue의 앞에서 작업을 가져온다(FIFO). 밖에서 추가한 작업은 공용 queue에
+//! 들어가 추가된 순서대로 실행된다.
+class ThreadPool {
+public:
+  //! workerCount가 0이면 하드웨어 thread 개수만큼 생성한다.
+  explicit ThreadPool(size_t workerCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  size_t WorkerCount() const { return workers.size(); }
+
+  //! 작업을 queue에 추가한다. 완료를 기다리지 않는다.
+  //! worker 안에서 호출하면 그 worker의 queue에 들어가므로, 큰 작업을 나눈
+  //! 하위 작업은 같은 worker가 이어서 실행하고 남는 것은 다른 worker가 가져간다.
+  void Submit(std::function<void()> task);
+
+  //! 모든 작업을 병렬로 실행하고 끝날 때까지 기다린다.
+  //! 호출 thread도 작업에 참여하므로 worker 안에서 호출해도 안전하다.
+  //! 작업 중 발생한 첫 번째 예외는 호출 thread로 다시 던진다.
+  void Run(const std::vector<std::function<void()>> &tasks);
+
+  //! [begin, end) 범위를 grain 크기로 나누어 fn(chunkBegin, chunkEnd)를
+  //! 병렬로 실행한다.
+  template <typename Fn>
+  void ParallelFor(size_t begin, size_t end, size_t grain, Fn fn) {
+    grain = std::max<size_t>(grain, 1);
+    std::vector<std::function<void()>> tasks;
+    for (size_t chunk = begin; chunk < end; chunk += grain) {
+      size_t chunkEnd = std::min(end, chunk + grain);
+      tasks.push_back([&fn, chunk, chunkEnd]() { fn(chunk, chunkEnd); });
+    }
+    Run(tasks);
+  }
+
+private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void WorkerLoop(size_t workerIndex);
+  //! 자신의 queue 뒤, 공용 queue 앞, 다른 worker queue 앞 순서로 꺼낸다.
+  bool TakeTask(size_t workerIndex, std::function<void()> &task);
+
+  std::vector<std::thread> workers;
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  //! worker가 아닌 thread에서 추가한 작업
+  WorkerQueue sharedQueue;
+  //! 모든 queue에 남은 작업 개수. worker가 잠들지 판단하는 데 사용한다.
+  std::atomic<size_t> pendingCount;
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool stopping;
+};
+
+//! 병렬 작업 하나가 맡는 기본 원소 수. 결과가 이 값과 thread 수에 관계없도록
+//! 작업을 나누는 곳에서 함께 사용한다.
+constexpr size_t kParallelGrain = 16 * 1024;
+
+//! pool이 nullptr이거나 작업이 grain 하나 이하이면 현재 thread에서
+//! [0, count)를 grain 단위로 실행한다. 그 밖에는 pool->ParallelFor와 같다.
+template <typename Fn>
+void ParallelFor(ThreadPool *pool, size_t count, size_t grain, Fn fn) {
+  grain = std::max<size_t>(grain, 1);
+  if (pool == nullptr || count <= grain) {
+    for (size_t begin = 0; begin < count; begin += grain)
+      fn(begin, std::min(count, begin + grain));
+    return;
+  }
+  pool->ParallelFor(0, count, grain, fn);
+}
+} // namespace Toybox
+
+#endif
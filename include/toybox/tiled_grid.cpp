@@ -0,0 +1,154 @@
+#include "toybox/tiled_grid.hpp"
+#include "toybox/profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace Toybox;
+
+namespace {
+//! 격자 index를 기록한다. winding은 Primitives::MakeGrid와 같다.
+void WriteGridIndexes(int xCellCount, int yCellCount, uint32_t *out) {
+  uint32_t xVertexLength = uint32_t(xCellCount) + 1;
+  size_t offset = 0;
+  for (uint32_t y = 0; y < uint32_t(yCellCount); ++y) {
+    uint32_t upperY = (y + 1) * xVertexLength;
+    uint32_t crntY = y * xVertexLength;
+    for (uint32_t x = 0; x < uint32_t(xCellCount); ++x, offset += 6) {
+      // upper triangle
+      out[offset] = crntY + x;
+      out[offset + 1] = upperY + x;
+      out[offset + 2] = upperY + x + 1;
+      // lower triangle
+      out[offset + 3] = crntY + x;
+      out[offset + 4] = upperY + x + 1;
+      out[offset + 5] = crntY + x + 1;
+    }
+  }
+}
+
+//! 좌표가 속한 tile 번호를 [0, tileCount) 안으로 맞춘다.
+//! int64_t로 바꾸기 전에 double에서 자르므로 아주 큰 좌표나 NaN도 안전하다.
+int64_t ClampTile(double coordinate, double tileLength, int64_t tileCount) {
+  double tile = std::floor(coordinate / tileLength);
+  if (!(tile > 0.0))
+    return 0;
+  if (tile >= double(tileCount - 1))
+    return tileCount - 1;
+  return int64_t(tile);
+}
+} // namespace
+
+TiledGrid::TiledGrid(const TiledGridParams &params) : params(params) {
+  if (params.xCellCount <= 0 || params.yCellCount <= 0 ||
+      params.tileCellCount <= 0)
+    throw std::runtime_error("grid와 tile의 칸 수는 0보다 커야 합니다.");
+  if (!(params.gridSize > 0.0f) || std::isinf(params.gridSize))
+    throw std::runtime_error("gridSize는 0보다 큰 유한한 값이어야 합니다.");
+  //=> tile 안의 index는 uint32_t 범위여야 한다. int에서 넘치지 않도록
+  //=> 먼저 64bit로 넓힌다.
+  const int64_t tileCellCount = params.tileCellCount;
+  if ((tileCellCount + 1) * (tileCellCount + 1) > int64_t(UINT32_MAX))
+    throw std::runtime_error("tile 크기가 너무 큽니다.");
+
+  //=> 올림 나눗셈. 칸 수가 int64_t 최대값에 가까워도 넘치지 않는다.
+  tileCountX = (params.xCellCount - 1) / tileCellCount + 1;
+  tileCountY = (params.yCellCount - 1) / tileCellCount + 1;
+
+  fullTileIndexes.resize(size_t(params.tileCellCount) * params.tileCellCount *
+                         6);
+  WriteGridIndexes(params.tileCellCount, params.tileCellCount,
+                   fullTileIndexes.data());
+}
+
+GridTile TiledGrid::Tile(int64_t tileX, int64_t tileY) const {
+  if (tileX < 0 || tileY < 0 || tileX >= tileCountX || tileY >= tileCountY)
+    throw std::runtime_error("tile 번호가 범위를 벗어났습니다.");
+
+  GridTile tile;
+  tile.tileX = tileX;
+  tile.tileY = tileY;
+  tile.cellX = tileX * params.tileCellCount;
+  tile.cellY = tileY * params.tileCellCount;
+  //=> 마지막 tile은 남은 칸 수만큼만 가진다.
+  tile.xCellCount = int(std::min<int64_t>(params.tileCellCount,
+                                          params.xCellCount - tile.cellX));
+  tile.yCellCount = int(std::min<int64_t>(params.tileCellCount,
+                                          params.yCellCount - tile.cellY));
+  tile.worldOffset[0] = double(params.gridSize) * double(tile.cellX);
+  tile.worldOffset[1] = double(params.gridSize) * double(tile.cellY);
+  tile.worldOffset[2] = 0.0;
+  return tile;
+}
+
+void TiledGrid::TileAt(double worldX, double worldY, int64_t &tileX,
+                       int64_t &tileY) const {
+  double tileLength = double(params.gridSize) * params.tileCellCount;
+  tileX = ClampTile(worldX, tileLength, tileCountX);
+  tileY = ClampTile(worldY, tileLength, tileCountY);
+}
+
+size_t TiledGrid::VertexCount(const GridTile &tile) {
+  return size_t(tile.xCellCount + 1) * (tile.yCellCount + 1);
+}
+
+size_t TiledGrid::IndexCount(const GridTile &tile) {
+  return size_t(tile.xCellCount) * tile.yCellCount * 6;
+}
+
+void TiledGrid::MakeTile(const GridTile &tile, Mesh &out) const {
+  TOYBOX_PROFILE_SCOPE(profile, "TiledGrid::MakeTile");
+  TOYBOX_PROFILE_OUTPUT(profile, VertexCount(tile), IndexCount(tile), 0);
+  out.vertexes.resize(VertexCount(tile));
+  out.indexes.resize(IndexCount(tile));
+
+  const int xVertexLength = tile.xCellCount + 1;
+  const int64_t globalXVertexLength = params.xCellCount + 1;
+  const double gridSize = params.gridSize;
+  const float normalZ = params.system == CoordSystemEnum::LEFTHAND ? -1 : 1;
+  const CounterRandom random(params.colorSeed);
+  std::vector<float> rgb(size_t(xVertexLength) * 3);
+
+  //> vertex 정보 생성하기
+  Vertex *vertex = out.vertexes.data();
+  for (int y = 0; y <= tile.yCellCount; ++y) {
+    int64_t globalY = tile.cellY + y;
+
+    //=> color: 전체 grid의 vertex 번호 기준이므로 Primitives::MakeGrid와
+    //=> 같은 seed면 같은 색상이 나온다. counter는 64bit 전체를 사용하므로
+    //=> vertex가 2^32개를 넘는 지형에서도 색상이 반복되지 않는다.
+    int64_t firstVertex = globalY * globalXVertexLength + tile.cellX;
+    random.Fill(rgb.data(), rgb.size(), uint64_t(firstVertex) * 3);
+
+    float localY = float(gridSize * y);
+    float texcoordY = float(1.0 - double(globalY) / double(params.yCellCount));
+    for (int x = 0; x <= tile.xCellCount; ++x, ++vertex) {
+      int64_t globalX = tile.cellX + x;
+      vertex->x = float(gridSize * x);
+      vertex->y = localY;
+      vertex->z = 0.0f;
+      vertex->r = rgb[x * 3];
+      vertex->g = rgb[x * 3 + 1];
+      vertex->b = rgb[x * 3 + 2];
+      vertex->nx = 0.0f;
+      vertex->ny = 0.0f;
+      vertex->nz = normalZ;
+      vertex->tx = float(double(globalX) / double(params.xCellCount));
+      vertex->ty = texcoordY;
+    }
+  }
+
+  //> index 정보 생성하기
+  if (tile.xCellCount == params.tileCellCount &&
+      tile.yCellCount == params.tileCellCount)
+    std::copy(fullTileIndexes.begin(), fullTileIndexes.end(),
+              out.indexes.begin());
+  else
+    WriteGridIndexes(tile.xCellCount, tile.yCellCount, out.indexes.data());
+}
+
+Mesh TiledGrid::MakeTile(int64_t tileX, int64_t tileY) const {
+  Mesh mesh;
+  MakeTile(Tile(tileX, tileY), mesh);
+  return mesh;
+}
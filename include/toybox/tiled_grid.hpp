@@ -0,0 +1,95 @@
+#ifndef TOYBOX_TILED_GRID_H
+#define TOYBOX_TILED_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <toybox/primitives.hpp>
+#include <toybox/random.hpp>
+#include <toybox/vertex.hpp>
+#include <vector>
+
+namespace Toybox {
+
+//! 전체 지형 크기와 tile 크기
+struct TiledGridParams {
+  CoordSystemEnum system;
+  int64_t xCellCount; // 지형 전체의 x 방향 칸 수
+  int64_t yCellCount; // 지형 전체의 y 방향 칸 수
+  float gridSize;     // 칸 한 변의 길이 (0보다 큰 유한한 값)
+  int tileCellCount;  // tile 한 변의 칸 수
+  uint64_t colorSeed = kDefaultRandomSeed;
+};
+
+//! tile 하나의 위치 정보
+//! tile의 vertex 좌표는 worldOffset 기준의 지역 좌표이다. (큰 지형에서 float
+//! 정밀도를 유지하기 위함) 월드 좌표 = worldOffset + position.
+struct GridTile {
+  int64_t tileX;
+  int64_t tileY;
+  int64_t cellX; // 첫 칸의 전체 지형 기준 번호
+  int64_t cellY;
+  int xCellCount;
+  int yCellCount;
+  double worldOffset[3];
+};
+
+//! 큰 grid를 고정 크기 tile로 나누어 필요할 때 생성한다.
+//! - 이웃한 tile은 경계 vertex를 각자 가지며, 두 vertex의 position(월드 좌표),
+//!   texcoord, normal, color는 같다.
+//! - texcoord는 지형 전체 기준 [0, 1]이다.
+//! - color는 전체 지형의 vertex 번호로 정해지므로 tile 순서와 관계없다.
+//! 메모리 사용량은 지형 크기가 아니라 tile 크기에 비례한다.
+class TiledGrid {
+public:
+  explicit TiledGrid(const TiledGridParams &params);
+
+  int64_t TileCountX() const { return tileCountX; }
+  int64_t TileCountY() const { return tileCountY; }
+  const TiledGridParams &Params() const { return params; }
+
+  //! 범위를 벗어나면 예외를 던진다.
+  GridTile Tile(int64_t tileX, int64_t tileY) const;
+
+  //! 월드 좌표가 속한 tile 번호. 지형 밖이면 가장 가까운 tile을 반환한다.
+  void TileAt(double worldX, double worldY, int64_t &tileX,
+              int64_t &tileY) const;
+
+  static size_t VertexCount(const GridTile &tile);
+  static size_t IndexCount(const GridTile &tile);
+
+  //! tile을 생성한다. out의 buffer는 재사용된다.
+  void MakeTile(const GridTile &tile, Mesh &out) const;
+  Mesh MakeTile(int64_t tileX, int64_t tileY) const;
+
+  //! [tileXBegin, tileXEnd) x [tileYBegin, tileYEnd) 범위의 tile을 차례로
+  //! 생성해 fn(const GridTile &, const Mesh &)로 전달한다.
+  //! Mesh 하나를 재사용하므로, 보관하려면 fn 안에서 복사해야 한다.
+  template <typename Fn>
+  void ForEachTile(int64_t tileXBegin, int64_t tileYBegin, int64_t tileXEnd,
+                   int64_t tileYEnd, Fn fn) const {
+    Mesh mesh;
+    for (int64_t tileY = tileYBegin; tileY < tileYEnd; ++tileY) {
+      for (int64_t tileX = tileXBegin; tileX < tileXEnd; ++tileX) {
+        GridTile tile = Tile(tileX, tileY);
+        MakeTile(tile, mesh);
+        fn(static_cast<const GridTile &>(tile),
+           static_cast<const Mesh &>(mesh));
+      }
+    }
+  }
+
+  template <typename Fn> void ForEachTile(Fn fn) const {
+    ForEachTile(0, 0, tileCountX, tileCountY, fn);
+  }
+
+private:
+  TiledGridParams params;
+  int64_t tileCountX;
+  int64_t tileCountY;
+
+  //! 가득 찬 tile의 index는 모두 같으므로 한 번만 만든다.
+  std::vector<uint32_t> fullTileIndexes;
+};
+} // namespace Toybox
+
+#endif
@@ -13,7 +13,7 @@ class Utils {
 
 public:
   Utils() {
-    auto seed = GetSeed();
+    auto &seed = GetSeed();
     this->timeSeed =
         std::chrono::high_resolution_clock::now().time_since_epoch().count();
     std::seed_seq ss{uint32_t(timeSeed & 0xffffffff), uint32_t(timeSeed >> 32)};
@@ -0,0 +1,140 @@
+#ifndef TOYBOX_VERTEX_LAYOUT_H
+#define TOYBOX_VERTEX_LAYOUT_H
+
+#include <cstdint>
+#include <toybox/vertex.hpp>
+#include <type_traits>
+#include <vector>
+
+namespace Toybox {
+
+//! Vertex가 가지는 속성 mask
+enum VertexAttributeEnum : uint32_t {
+  ATTR_POSITION = 1 << 0,
+  ATTR_COLOR = 1 << 1,
+  ATTR_NORMAL = 1 << 2,
+  ATTR_TEXCOORD = 1 << 3,
+  ATTR_ALL = ATTR_POSITION | ATTR_COLOR | ATTR_NORMAL | ATTR_TEXCOORD
+};
+
+namespace detail {
+struct PositionAttribute {
+  float x;
+  float y;
+  float z;
+};
+struct ColorAttribute {
+  float r;
+  float g;
+  float b;
+};
+struct NormalAttribute {
+  float nx;
+  float ny;
+  float nz;
+};
+struct TexcoordAttribute {
+  float tx;
+  float ty;
+};
+
+//! 사용하지 않는 속성은 크기가 없는 빈 base로 대체한다.
+template <int Slot> struct EmptyAttribute {};
+
+template <bool Enabled, typename Attribute, int Slot>
+using SelectAttribute =
+    typename std::conditional<Enabled, Attribute, EmptyAttribute<Slot>>::type;
+} // namespace detail
+
+#if defined(_MSC_VER)
+#define TOYBOX_EMPTY_BASES __declspec(empty_bases)
+#else
+#define TOYBOX_EMPTY_BASES
+#endif
+
+//! Mask에 포함된 속성만 저장하는 vertex.
+//! 속성 순서는 Toybox::Vertex와 같다. (position, color, normal, texcoord)
+template <uint32_t Mask>
+struct TOYBOX_EMPTY_BASES LayoutVertex
+    : detail::SelectAttribute<(Mask & ATTR_POSITION) != 0,
+                              detail::PositionAttribute, 0>,
+      detail::SelectAttribute<(Mask & ATTR_COLOR) != 0,
+                              detail::ColorAttribute, 1>,
+      detail::SelectAttribute<(Mask & ATTR_NORMAL) != 0,
+                              detail::NormalAttribute, 2>,
+      detail::SelectAttribute<(Mask & ATTR_TEXCOORD) != 0,
+                              detail::TexcoordAttribute, 3> {
+  static_assert((Mask & ATTR_POSITION) != 0,
+                "vertex layout에는 position이 반드시 포함되어야 합니다.");
+  static_assert((Mask & ~uint32_t(ATTR_ALL)) == 0,
+                "알 수 없는 vertex 속성입니다.");
+
+  static constexpr uint32_t kMask = Mask;
+  static constexpr bool kHasColor = (Mask & ATTR_COLOR) != 0;
+  static constexpr bool kHasNormal = (Mask & ATTR_NORMAL) != 0;
+  static constexpr bool kHasTexcoord = (Mask & ATTR_TEXCOORD) != 0;
+};
+
+template <uint32_t Mask> struct LayoutMesh {
+  using VertexType = LayoutVertex<Mask>;
+
+  std::vector<VertexType> vertexes;
+  std::vector<uint32_t> indexes;
+};
+
+//=> 자주 사용하는 layout
+using PositionMesh = LayoutMesh<ATTR_POSITION>;
+using ColoredLineMesh = LayoutMesh<ATTR_POSITION | ATTR_COLOR>;
+using LitMesh = LayoutMesh<ATTR_POSITION | ATTR_NORMAL | ATTR_TEXCOORD>;
+
+namespace detail {
+//> Layout에 없는 속성은 무시하는 setter
+template <typename V>
+void SetColor(V &v, float r, float g, float b, std::true_type) {
+  v.r = r;
+  v.g = g;
+  v.b = b;
+}
+template <typename V> void SetColor(V &, float, float, float, std::false_type) {}
+
+template <typename V>
+void SetNormal(V &v, float nx, float ny, float nz, std::true_type) {
+  v.nx = nx;
+  v.ny = ny;
+  v.nz = nz;
+}
+template <typename V>
+void SetNormal(V &, float, float, float, std::false_type) {}
+
+template <typename V> void SetTexcoord(V &v, float tx, float ty, std::true_type) {
+  v.tx = tx;
+  v.ty = ty;
+}
+template <typename V> void SetTexcoord(V &, float, float, std::false_type) {}
+} // namespace detail
+
+//! Toybox::Mesh에서 Mask에 포함된 속성만 추려낸다.
+template <uint32_t Mask> LayoutMesh<Mask> ToLayout(const Mesh &mesh) {
+  using VertexType = LayoutVertex<Mask>;
+  LayoutMesh<Mask> result;
+  result.vertexes.resize(mesh.vertexes.size());
+  for (size_t i = 0; i < mesh.vertexes.size(); ++i) {
+    const Vertex &src = mesh.vertexes[i];
+    VertexType &dst = result.vertexes[i];
+    dst.x = src.x;
+    dst.y = src.y;
+    dst.z = src.z;
+    detail::SetColor(dst, src.r, src.g, src.b,
+                     std::integral_constant<bool, VertexType::kHasColor>());
+    detail::SetNormal(dst, src.nx, src.ny, src.nz,
+                      std::integral_constant<bool, VertexType::kHasNormal>());
+    detail::SetTexcoord(
+        dst, src.tx, src.ty,
+        std::integral_constant<bool, VertexType::kHasTexcoord>());
+  }
+  result.indexes = mesh.indexes;
+  return result;
+}
+} // namespace Toybox
+
+#endif